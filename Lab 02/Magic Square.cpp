@@ -1,53 +1,122 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-// Function to print the magic square
-void printSquare(vector<vector<int>> &square) {
-    int n = square.size();
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++)
-            cout << setw(4) << square[i][j] << " ";
-        cout << "\n";
+// Every cell of the squares below has a closed form, so the square is produced one row at a
+// time and never held in memory. Orders of 10^4 and more only need a few rows of O(n) memory.
+
+// Buffered writer for right-aligned integers (replaces cout << setw)
+class RowWriter {
+    FILE *out;
+    vector<char> buffer;
+    size_t used = 0;
+    int width;
+
+public:
+    RowWriter(FILE *out, int width) : out(out), buffer(1 << 20), width(width) {}
+    ~RowWriter() { flush(); }
+
+    void flush() {
+        fwrite(buffer.data(), 1, used, out);
+        used = 0;
     }
-}
 
-// Siamese method for odd n
-vector<vector<int>> generateOdd(int n) {
-    vector<vector<int>> square(n, vector<int>(n, 0));
-    int i = 0, j = n / 2;
-
-    for (int num = 1; num <= n * n; num++) {
-        square[i][j] = num;
-        int newi = (i - 1 + n) % n;
-        int newj = (j + 1) % n;
-
-        if (square[newi][newj])
-            i = (i + 1) % n;
-        else {
-            i = newi;
-            j = newj;
+    void writeRow(const int *row, int n) {
+        for (int j = 0; j < n; j++) {
+            if (used + width + 2 > buffer.size()) flush();
+            char digits[12];
+            int len = 0;
+            unsigned value = row[j];
+            do {
+                digits[len++] = char('0' + value % 10);
+                value /= 10;
+            } while (value);
+            for (int pad = len; pad < width; pad++) buffer[used++] = ' ';
+            while (len) buffer[used++] = digits[--len];
+            buffer[used++] = ' ';
         }
+        if (used + 1 > buffer.size()) flush();
+        buffer[used++] = '\n';
+    }
+};
+
+// Siamese method for odd n: 1 at the top middle, then up-right, down when blocked.
+// Cell (i, j) holds n * ((i + j + 1 + n/2) mod n) + ((i + 2j + 1) mod n) + 1
+void oddRow(int n, int i, int *row) {
+    int high = (i + 1 + n / 2) % n, low = (i + 1) % n;
+    for (int j = 0; j < n; j++) {
+        row[j] = high * n + low + 1;
+        if (++high == n) high = 0;
+        low += 2;
+        if (low >= n) low -= n;
     }
-    return square;
 }
 
-// Doubly even magic square (n % 4 == 0)
-vector<vector<int>> generateDoublyEven(int n) {
-    vector<vector<int>> square(n, vector<int>(n));
-    int num = 1, maxNum = n * n;
+// Doubly even magic square (n % 4 == 0): row-major 1..n^2 with the cells on the diagonals
+// of each 4x4 block replaced by their complement n^2 + 1 - value
+void doublyEvenRow(int n, int i, int *row) {
+    int maxNum = n * n, num = i * n + 1;
+    for (int j = 0; j < n; j++, num++) {
+        if ((i % 4 == j % 4) || ((i % 4 + j % 4) == 3))
+            row[j] = maxNum + 1 - num;
+        else
+            row[j] = num;
+    }
+}
 
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            square[i][j] = num++;
+// Singly even magic square (n = 4m + 2), Conway's LUX method. Each cell of the odd square of
+// order 2m + 1 becomes a 2x2 block holding 4(v - 1) + 1..4 in the order of its letter:
+// m + 1 rows of L, one row of U, m - 1 rows of X, with the middle L and the U below it swapped
+void singlyEvenRow(int n, int i, int *row, vector<int> &oddBuffer) {
+    static const int LUX[3][2][2] = {
+        {{4, 1}, {2, 3}},       // L
+        {{1, 4}, {2, 3}},       // U
+        {{1, 4}, {3, 2}}        // X
+    };
+    int half = n / 2, m = (n - 2) / 4;
+    int blockRow = i / 2, sub = i % 2;
+    oddRow(half, blockRow, oddBuffer.data());
+
+    for (int block = 0; block < half; block++) {
+        int letter = blockRow <= m ? 0 : blockRow == m + 1 ? 1 : 2;
+        if (block == m && blockRow == m) letter = 1;
+        else if (block == m && blockRow == m + 1) letter = 0;
+        int base = 4 * (oddBuffer[block] - 1);
+        row[2 * block] = base + LUX[letter][sub][0];
+        row[2 * block + 1] = base + LUX[letter][sub][1];
+    }
+}
+
+// Writes the square row by row (out may be null to only check it) and checks that every row,
+// column and both diagonals add up to the magic constant, using O(n) extra memory
+bool streamSquare(int n, FILE *out) {
+    long long magicConstant = (long long)n * ((long long)n * n + 1) / 2;
+    vector<int> row(n), oddBuffer(n / 2);
+    vector<long long> columnSums(n, 0);
+    long long diagonal = 0, antiDiagonal = 0;
+    bool rowsOk = true;
+
+    int width = max(4, (int)to_string((long long)n * n).size());
+    unique_ptr<RowWriter> writer(out ? new RowWriter(out, width) : nullptr);
 
-    // Replace values at certain positions with complementary numbers
     for (int i = 0; i < n; i++) {
+        if (n % 2 == 1) oddRow(n, i, row.data());
+        else if (n % 4 == 0) doublyEvenRow(n, i, row.data());
+        else singlyEvenRow(n, i, row.data(), oddBuffer);
+
+        long long rowSum = 0;
         for (int j = 0; j < n; j++) {
-            if ((i % 4 == j % 4) || ((i % 4 + j % 4) == 3))
-                square[i][j] = maxNum + 1 - square[i][j];
+            rowSum += row[j];
+            columnSums[j] += row[j];
         }
+        rowsOk &= rowSum == magicConstant;
+        diagonal += row[i];
+        antiDiagonal += row[n - 1 - i];
+        if (writer) writer->writeRow(row.data(), n);
     }
-    return square;
+
+    bool columnsOk = all_of(columnSums.begin(), columnSums.end(),
+                            [magicConstant](long long sum) { return sum == magicConstant; });
+    return rowsOk && columnsOk && diagonal == magicConstant && antiDiagonal == magicConstant;
 }
 
 int main() {
@@ -59,25 +128,40 @@ int main() {
         cout << "Magic square not possible for n < 3\n";
         return 0;
     }
+    if (n > 46340) {
+        cout << "n^2 must fit in an int, so n can be at most 46340\n";
+        return 0;
+    }
 
-    int magicConstant = n * (n * n + 1) / 2;
-    cout << "Magic constant (sum of each row/column/diagonal): " 
-         << magicConstant << "\n\n";
+    long long magicConstant = (long long)n * ((long long)n * n + 1) / 2;
+    cout << "Magic constant (sum of each row/column/diagonal): "
+         << magicConstant << "\n";
+    cout << "Method: " << (n % 2 == 1 ? "Siamese (odd)" : n % 4 == 0 ? "Doubly even" : "LUX (singly even)") << "\n";
 
-    vector<vector<int>> square;
+    // Large squares are better written to a file; "-" prints here, "none" only checks the sums
+    string target;
+    cout << "Enter output file (- to print here, none to only verify): ";
+    cin >> target;
+    cout << "\n" << flush;
 
-    if (n % 2 == 1) {
-        square = generateOdd(n);
-    } 
-    else if (n % 4 == 0) {
-        square = generateDoublyEven(n);
-    } 
-    else {
-        cout << "Singly-even order (n=2 mod 4) not implemented in this code.\n";
-        return 0;
+    FILE *out = nullptr;
+    if (target == "-") out = stdout;
+    else if (target != "none") {
+        out = fopen(target.c_str(), "wb");
+        if (!out) {
+            cout << "Could not open " << target << "\n";
+            return 0;
+        }
     }
 
-    printSquare(square);
+    auto start = chrono::steady_clock::now();
+    bool valid = streamSquare(n, out);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (out && out != stdout) fclose(out);
+    else fflush(stdout);
 
+    cout << "\n" << (valid ? "Verified: every row, column and diagonal sums to " : "Check FAILED for magic constant ")
+         << magicConstant << "\n";
+    cout << "Time taken: " << seconds << " s\n";
     return 0;
 }
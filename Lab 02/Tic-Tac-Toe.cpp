@@ -1,33 +1,108 @@
 #include <iostream>
-#include <vector>
 #include <string>
+#include <cstdint>
 
 class TicTacToe {
 private:
-    char board[3][3];
+    // Bitboard: one 9-bit mask per player, bit (3 * row + col) set if the cell is taken
+    uint16_t xBits = 0;
+    uint16_t oBits = 0;
     char AI_PLAYER = 'X';
     char HUMAN_PLAYER = 'O';
     char EMPTY = ' ';
+    bool verbose = true;        // Print the AI's reasoning
+
+    static constexpr uint16_t FULL_BOARD = 0x1FF;
+    static constexpr uint16_t WIN_LINES[8] = {
+        0x007, 0x038, 0x1C0,    // Rows
+        0x049, 0x092, 0x124,    // Columns
+        0x111, 0x054            // Diagonals
+    };
+
+    uint16_t& bitsOf(char player) {
+        return player == 'X' ? xBits : oBits;
+    }
+
+    uint16_t emptyCells() const {
+        return FULL_BOARD & ~(xBits | oBits);
+    }
+
+    char cellAt(int row, int col) const {
+        uint16_t bit = 1 << (3 * row + col);
+        if (xBits & bit) return 'X';
+        if (oBits & bit) return 'O';
+        return EMPTY;
+    }
+
+    static bool hasLine(uint16_t bits) {
+        for (uint16_t line : WIN_LINES)
+            if ((bits & line) == line) return true;
+        return false;
+    }
+
+    static constexpr uint16_t CENTER = 0x010;
+    static constexpr uint16_t CORNERS = 0x145;      // Cells 0, 2, 6, 8
+    static constexpr uint16_t EDGES = 0x0AA;        // Cells 1, 3, 5, 7
+
+    // Threat table: completions[bits] = cells that finish a line for a player holding
+    // `bits` (two cells of the line taken, the third one missing). Masked with the empty
+    // cells it gives the winning moves, so the rules need no board scans.
+    struct ThreatTable {
+        uint16_t completions[512];
+    };
+
+    static constexpr ThreatTable buildThreatTable() {
+        ThreatTable table{};
+        for (int bits = 0; bits < 512; bits++) {
+            for (uint16_t line : WIN_LINES) {
+                uint16_t missing = line & ~bits;
+                if (missing && !(missing & (missing - 1))) table.completions[bits] |= missing;
+            }
+        }
+        return table;
+    }
+
+    static const ThreatTable& threatTable() {
+        static constexpr ThreatTable table = buildThreatTable();
+        return table;
+    }
+
+    // Empty cells where `bits` would complete a line
+    uint16_t threatsOf(uint16_t bits) const {
+        return threatTable().completions[bits] & emptyCells();
+    }
+
+    static std::pair<int, int> firstCell(uint16_t cells) {
+        if (!cells) return {-1, -1};
+        int cell = __builtin_ctz(cells);
+        return {cell / 3, cell % 3};
+    }
 
 public:
     TicTacToe() {
         initializeBoard();
     }
 
+    void setPlayers(char ai, char human) {
+        AI_PLAYER = ai;
+        HUMAN_PLAYER = human;
+    }
+
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+
     // Initialize empty board
     void initializeBoard() {
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                board[i][j] = EMPTY;
-            }
-        }
+        xBits = 0;
+        oBits = 0;
     }
 
     // Display the current board
     void displayBoard() {
         std::cout << "\n   0   1   2\n";
         for (int i = 0; i < 3; i++) {
-            std::cout << i << "  " << board[i][0] << " | " << board[i][1] << " | " << board[i][2] << "\n";
+            std::cout << i << "  " << cellAt(i, 0) << " | " << cellAt(i, 1) << " | " << cellAt(i, 2) << "\n";
             if (i < 2) std::cout << "  ---|---|---\n";
         }
         std::cout << "\n";
@@ -35,71 +110,27 @@ public:
 
     // Check if position is valid and empty
     bool isValidMove(int row, int col) {
-        return (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == EMPTY);
+        return (row >= 0 && row < 3 && col >= 0 && col < 3 && (emptyCells() >> (3 * row + col) & 1));
     }
 
     // Make a move on the board
     void makeMove(int row, int col, char player) {
         if (isValidMove(row, col)) {
-            board[row][col] = player;
+            bitsOf(player) |= 1 << (3 * row + col);
         }
     }
 
-    // Check for winner or draw
+    // Check for winner or draw: eight mask tests and a full-board test
     char checkGameStatus() {
-        // Check rows
-        for (int i = 0; i < 3; i++) {
-            if (board[i][0] == board[i][1] && board[i][1] == board[i][2] && board[i][0] != EMPTY) {
-                return board[i][0];
-            }
-        }
-
-        // Check columns
-        for (int j = 0; j < 3; j++) {
-            if (board[0][j] == board[1][j] && board[1][j] == board[2][j] && board[0][j] != EMPTY) {
-                return board[0][j];
-            }
-        }
-
-        // Check diagonals
-        if (board[0][0] == board[1][1] && board[1][1] == board[2][2] && board[0][0] != EMPTY) {
-            return board[0][0];
-        }
-        if (board[0][2] == board[1][1] && board[1][1] == board[2][0] && board[0][2] != EMPTY) {
-            return board[0][2];
-        }
-
-        // Check for draw
-        bool boardFull = true;
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == EMPTY) {
-                    boardFull = false;
-                    break;
-                }
-            }
-        }
-        if (boardFull) return 'D'; // Draw
-
+        if (hasLine(xBits)) return 'X';
+        if (hasLine(oBits)) return 'O';
+        if ((xBits | oBits) == FULL_BOARD) return 'D'; // Draw
         return 'C'; // Continue playing
     }
 
-    // RULE 1: Win if possible
+    // RULE 1: Win if possible (one table lookup)
     std::pair<int, int> findWinningMove(char player) {
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (isValidMove(i, j)) {
-                    // Try the move
-                    board[i][j] = player;
-                    if (checkGameStatus() == player) {
-                        board[i][j] = EMPTY; // Undo move
-                        return {i, j};
-                    }
-                    board[i][j] = EMPTY; // Undo move
-                }
-            }
-        }
-        return {-1, -1}; // No winning move found
+        return firstCell(threatsOf(bitsOf(player)));
     }
 
     // RULE 2: Block opponent's winning move
@@ -107,72 +138,75 @@ public:
         return findWinningMove(opponent); // Same logic, different player
     }
 
-    // RULE 3: Take center if available
-    std::pair<int, int> takeCenter() {
-        if (isValidMove(1, 1)) {
-            return {1, 1};
+    // RULE 3: Create a fork (a move that leaves two winning threats at once)
+    std::pair<int, int> findForkMove(char player) {
+        uint16_t bits = bitsOf(player);
+        for (uint16_t moves = emptyCells(); moves; moves &= moves - 1) {
+            uint16_t bit = moves & -moves;
+            uint16_t threats = threatTable().completions[bits | bit] & emptyCells() & ~bit;
+            if (__builtin_popcount(threats) >= 2) return firstCell(bit);
         }
         return {-1, -1};
     }
 
-    // RULE 4: Take corners (strategic positions)
+    // RULE 4: Take center if available
+    std::pair<int, int> takeCenter() {
+        return firstCell(emptyCells() & CENTER);
+    }
+
+    // RULE 5: Take corners (strategic positions)
     std::pair<int, int> takeCorner() {
-        std::vector<std::pair<int, int>> corners = {{0, 0}, {0, 2}, {2, 0}, {2, 2}};
-        for (auto corner : corners) {
-            if (isValidMove(corner.first, corner.second)) {
-                return corner;
-            }
-        }
-        return {-1, -1};
+        return firstCell(emptyCells() & CORNERS);
     }
 
-    // RULE 5: Take any available edge
+    // RULE 6: Take any available edge
     std::pair<int, int> takeEdge() {
-        std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 0}, {1, 2}, {2, 1}};
-        for (auto edge : edges) {
-            if (isValidMove(edge.first, edge.second)) {
-                return edge;
-            }
-        }
-        return {-1, -1};
+        return firstCell(emptyCells() & EDGES);
     }
 
     // AI Strategy: Apply rules in order of priority
     std::pair<int, int> getAIMove() {
-        std::cout << "AI is thinking...\n";
+        if (verbose) std::cout << "AI is thinking...\n";
 
         // RULE 1: Try to win
         auto move = findWinningMove(AI_PLAYER);
         if (move.first != -1) {
-            std::cout << "AI Strategy: Going for the WIN!\n";
+            if (verbose) std::cout << "AI Strategy: Going for the WIN!\n";
             return move;
         }
 
         // RULE 2: Block human from winning
         move = findBlockingMove(HUMAN_PLAYER);
         if (move.first != -1) {
-            std::cout << "AI Strategy: Blocking your winning move!\n";
+            if (verbose) std::cout << "AI Strategy: Blocking your winning move!\n";
+            return move;
+        }
+
+        // RULE 3: Create a fork
+        move = findForkMove(AI_PLAYER);
+        if (move.first != -1) {
+            if (verbose) std::cout << "AI Strategy: Creating a fork!\n";
             return move;
         }
 
-        // RULE 3: Take center
+        // RULE 4: Take center
         move = takeCenter();
         if (move.first != -1) {
-            std::cout << "AI Strategy: Taking the center position!\n";
+            if (verbose) std::cout << "AI Strategy: Taking the center position!\n";
             return move;
         }
 
-        // RULE 4: Take corner
+        // RULE 5: Take corner
         move = takeCorner();
         if (move.first != -1) {
-            std::cout << "AI Strategy: Taking a corner position!\n";
+            if (verbose) std::cout << "AI Strategy: Taking a corner position!\n";
             return move;
         }
 
-        // RULE 5: Take edge
+        // RULE 6: Take edge
         move = takeEdge();
         if (move.first != -1) {
-            std::cout << "AI Strategy: Taking an edge position!\n";
+            if (verbose) std::cout << "AI Strategy: Taking an edge position!\n";
             return move;
         }
 
@@ -254,6 +288,8 @@ public:
     }
 };
 
+// main() is left out when the file is included by the tournament harness
+#ifndef ENGINE_NO_MAIN
 int main() {
     TicTacToe game;
     
@@ -270,4 +306,5 @@ int main() {
     
     std::cout << "Thanks for playing! \n";
     return 0;
-}
\ No newline at end of file
+}
+#endif
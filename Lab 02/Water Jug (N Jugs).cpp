@@ -0,0 +1,426 @@
+#include <bits/stdc++.h>
+
+// Water jug problem with any number of jugs, solved by a level-synchronous parallel BFS.
+//
+// A state is packed into one 64-bit mixed-radix rank: jug i holding a_i litres contributes
+// a_i * stride_i, where stride_i = (capacity_0 + 1) * ... * (capacity_{i-1} + 1). A move
+// changes at most two jugs, so the successor rank is computed incrementally from the parent.
+
+const int MAX_JUGS = 16;
+const int NO_JUG = -1;                          // Tap (as a source) or drain (as a sink)
+const uint64_t NO_STATE = UINT64_MAX;
+
+struct NJugConfig {
+    std::vector<int> capacity;      // Capacity of each jug
+    std::vector<int> initial;       // Starting amount in each jug
+    bool infiniteSource;            // Jugs can be filled from a tap
+    bool infiniteSink;              // Jugs can be emptied down the drain
+    int target;                     // Target amount to achieve
+    bool targetIsTotal;             // Goal: all jugs together hold target (otherwise any single jug does)
+};
+
+// One action: fill `to` from the tap (from = NO_JUG), empty `from` (to = NO_JUG) or pour from -> to
+struct Move {
+    int from;
+    int to;
+};
+
+// Open-addressing hash set of ranks with linear probing. Ranks are stored + 1 so that 0
+// marks an empty slot; the table doubles when it is half full.
+class RankSet {
+private:
+    std::vector<uint64_t> slots = std::vector<uint64_t>(1024, 0);
+    size_t used = 0;
+
+    static uint64_t mix(uint64_t rank) {       // splitmix64 finaliser
+        rank = (rank ^ (rank >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        rank = (rank ^ (rank >> 27)) * 0x94D049BB133111EBULL;
+        return rank ^ (rank >> 31);
+    }
+
+    void place(uint64_t key) {
+        size_t mask = slots.size() - 1;
+        size_t i = mix(key - 1) & mask;
+        while (slots[i] != 0) i = (i + 1) & mask;
+        slots[i] = key;
+    }
+
+public:
+    bool insert(uint64_t rank) {
+        uint64_t key = rank + 1;
+        size_t mask = slots.size() - 1;
+        for (size_t i = mix(rank) & mask; slots[i] != 0; i = (i + 1) & mask)
+            if (slots[i] == key) return false;
+
+        if (2 * (used + 1) > slots.size()) {
+            std::vector<uint64_t> old(slots.size() * 2, 0);
+            old.swap(slots);
+            for (uint64_t stored : old)
+                if (stored != 0) place(stored);
+        }
+        place(key);
+        used++;
+        return true;
+    }
+};
+
+// States seen so far. Dense state spaces use one bit per rank (set with an atomic OR);
+// when the rank space is too large for memory, visited ranks go into hash sets split
+// into shards, each behind its own lock.
+class VisitedStates {
+private:
+    static constexpr uint64_t MAX_DENSE_BITS = 1ULL << 33;     // 1 GB of bits
+    static constexpr int SHARDS = 64;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> bits;
+    std::vector<RankSet> shards;
+    std::vector<std::mutex> locks;
+
+public:
+    static bool denseFor(uint64_t states) { return states <= MAX_DENSE_BITS; }
+
+    explicit VisitedStates(uint64_t states) {
+        if (denseFor(states)) {
+            bits.reset(new std::atomic<uint64_t>[(states + 63) / 64]());
+        } else {
+            shards.resize(SHARDS);
+            locks = std::vector<std::mutex>(SHARDS);
+        }
+    }
+
+    // Marks rank as seen; returns true for the thread that saw it first
+    bool insert(uint64_t rank) {
+        if (bits) {
+            std::atomic<uint64_t>& word = bits[rank >> 6];
+            uint64_t mask = 1ULL << (rank & 63);
+            if (word.load(std::memory_order_relaxed) & mask) return false;     // Cheap test before the RMW
+            return !(word.fetch_or(mask, std::memory_order_relaxed) & mask);
+        }
+        int shard = (int)((rank * 0x9E3779B97F4A7C15ULL) >> 58);
+        std::lock_guard<std::mutex> guard(locks[shard]);
+        return shards[shard].insert(rank);
+    }
+};
+
+class NJugSolver {
+private:
+    NJugConfig config;
+    int jugs;
+    uint64_t stride[MAX_JUGS + 1];  // stride[jugs] = number of ranks
+    std::vector<Move> moves;
+
+public:
+    struct Result {
+        bool found = false;
+        int depth = 0;
+        uint64_t statesVisited = 0;
+        std::vector<uint64_t> path;             // Ranks from the initial state to the goal
+        std::vector<Move> pathMoves;            // pathMoves[i] leads from path[i] to path[i + 1]
+        std::vector<uint64_t> levelSizes;       // New states found at each depth
+    };
+
+    explicit NJugSolver(const NJugConfig& cfg) : config(cfg), jugs((int)cfg.capacity.size()) {
+        stride[0] = 1;
+        for (int i = 0; i < jugs; i++) {
+            unsigned __int128 next = (unsigned __int128)stride[i] * (config.capacity[i] + 1);
+            stride[i + 1] = next > UINT64_MAX - 1 ? NO_STATE : (uint64_t)next;
+            if (stride[i + 1] == NO_STATE) break;
+        }
+
+        for (int i = 0; i < jugs; i++) {
+            if (config.infiniteSource) moves.push_back({NO_JUG, i});
+            if (config.infiniteSink) moves.push_back({i, NO_JUG});
+            for (int j = 0; j < jugs; j++)
+                if (i != j) moves.push_back({i, j});
+        }
+    }
+
+    // False if the mixed-radix rank does not fit in 64 bits
+    bool fitsIn64Bits() const {
+        for (int i = 1; i <= jugs; i++)
+            if (stride[i] == NO_STATE) return false;
+        return true;
+    }
+
+    uint64_t stateCount() const { return stride[jugs]; }
+
+    uint64_t encode(const int amount[]) const {
+        uint64_t rank = 0;
+        for (int i = 0; i < jugs; i++) rank += amount[i] * stride[i];
+        return rank;
+    }
+
+    void decode(uint64_t rank, int amount[]) const {
+        for (int i = 0; i < jugs; i++) amount[i] = (int)(rank / stride[i] % (config.capacity[i] + 1));
+    }
+
+    // Applies `move` to the state (rank, amount), updating amount in place; returns the
+    // new rank, or NO_STATE (amount unchanged) if the move does nothing
+    uint64_t apply(uint64_t rank, int amount[], const Move& move) const {
+        if (move.from == NO_JUG) {
+            int added = config.capacity[move.to] - amount[move.to];
+            if (added == 0) return NO_STATE;
+            amount[move.to] += added;
+            return rank + added * stride[move.to];
+        }
+        if (move.to == NO_JUG) {
+            int removed = amount[move.from];
+            if (removed == 0) return NO_STATE;
+            amount[move.from] = 0;
+            return rank - removed * stride[move.from];
+        }
+        int poured = std::min(amount[move.from], config.capacity[move.to] - amount[move.to]);
+        if (poured == 0) return NO_STATE;
+        amount[move.from] -= poured;
+        amount[move.to] += poured;
+        return rank - poured * stride[move.from] + poured * stride[move.to];
+    }
+
+    bool isGoal(const int amount[]) const {
+        if (config.targetIsTotal) {
+            long long total = 0;
+            for (int i = 0; i < jugs; i++) total += amount[i];
+            return total == config.target;
+        }
+        for (int i = 0; i < jugs; i++)
+            if (amount[i] == config.target) return true;
+        return false;
+    }
+
+    // Level-synchronous BFS: the frontier of depth d is split into chunks that threads take
+    // from a shared counter; each thread collects the new states it claims in its own list,
+    // and the lists become the frontier of depth d + 1. Every level is kept for the path.
+    // The helper threads are started once and wait between levels; a frontier of only a few
+    // chunks is expanded by the calling thread alone.
+    Result solve(int threadCount) const {
+        const size_t CHUNK = 1024;
+        const size_t PARALLEL_MIN = 4 * CHUNK;
+        Result result;
+        VisitedStates visited(stateCount());
+
+        int start[MAX_JUGS];
+        std::copy(config.initial.begin(), config.initial.end(), start);
+        uint64_t startRank = encode(start);
+        std::vector<std::vector<uint64_t>> levels = {{startRank}};
+        visited.insert(startRank);
+        result.levelSizes.push_back(1);
+        uint64_t goalRank = isGoal(start) ? startRank : NO_STATE;
+
+        // State of the level being expanded, shared with the helper threads
+        const std::vector<uint64_t>* frontier = nullptr;
+        std::vector<std::vector<uint64_t>> found(threadCount);
+        std::atomic<size_t> nextChunk(0);
+        std::atomic<uint64_t> sharedGoal(NO_STATE);
+
+        auto worker = [&](int id) {
+            std::vector<uint64_t>& mine = found[id];
+            int amount[MAX_JUGS];
+            size_t begin;
+            while ((begin = nextChunk.fetch_add(CHUNK)) < frontier->size()) {
+                size_t end = std::min(begin + CHUNK, frontier->size());
+                for (size_t i = begin; i < end; i++) {
+                    uint64_t rank = (*frontier)[i];
+                    decode(rank, amount);
+                    for (const Move& move : moves) {
+                        int next[MAX_JUGS];
+                        std::copy(amount, amount + jugs, next);
+                        uint64_t nextRank = apply(rank, next, move);
+                        if (nextRank == NO_STATE || !visited.insert(nextRank)) continue;
+                        mine.push_back(nextRank);
+                        if (isGoal(next)) {
+                            uint64_t none = NO_STATE;
+                            sharedGoal.compare_exchange_strong(none, nextRank);
+                        }
+                    }
+                }
+            }
+        };
+
+        // Barrier between levels: the calling thread bumps `level` to release the helpers,
+        // and waits until `busy` drops back to 0
+        std::mutex mutex;
+        std::condition_variable levelStart, levelDone;
+        int level = 0, busy = 0;
+        bool stop = false;
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < threadCount; t++) {
+            helpers.emplace_back([&, t] {
+                for (int seen = 0; ; ) {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        levelStart.wait(lock, [&] { return stop || level != seen; });
+                        if (stop) return;
+                        seen = level;
+                    }
+                    worker(t);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--busy == 0) levelDone.notify_one();
+                }
+            });
+        }
+
+        while (goalRank == NO_STATE && !levels.back().empty()) {
+            frontier = &levels.back();
+            nextChunk = 0;
+            if (!helpers.empty() && frontier->size() >= PARALLEL_MIN) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    busy = (int)helpers.size();
+                    level++;
+                }
+                levelStart.notify_all();
+                worker(0);
+                std::unique_lock<std::mutex> lock(mutex);
+                levelDone.wait(lock, [&] { return busy == 0; });
+            } else {
+                worker(0);
+            }
+
+            std::vector<uint64_t> nextLevel;
+            size_t total = 0;
+            for (const auto& list : found) total += list.size();
+            nextLevel.reserve(total);
+            for (auto& list : found) {
+                nextLevel.insert(nextLevel.end(), list.begin(), list.end());
+                std::vector<uint64_t>().swap(list);
+            }
+            result.levelSizes.push_back(nextLevel.size());
+            levels.push_back(std::move(nextLevel));
+            goalRank = sharedGoal.load();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        levelStart.notify_all();
+        for (auto& helper : helpers) helper.join();
+
+        for (uint64_t size : result.levelSizes) result.statesVisited += size;
+        if (goalRank == NO_STATE) return result;
+
+        // Walk back one level at a time: any state of the previous level with a move to the
+        // current state is a valid parent (levels are kept instead of per-state parent links)
+        result.found = true;
+        result.depth = (int)levels.size() - 1;
+        result.path.assign(levels.size(), 0);
+        result.pathMoves.resize(levels.size() - 1);
+        result.path.back() = goalRank;
+        for (int depth = result.depth; depth > 0; depth--) {
+            uint64_t child = result.path[depth];
+            bool linked = false;
+            int amount[MAX_JUGS], next[MAX_JUGS];
+            for (uint64_t parent : levels[depth - 1]) {
+                decode(parent, amount);
+                for (const Move& move : moves) {
+                    std::copy(amount, amount + jugs, next);
+                    if (apply(parent, next, move) == child) {
+                        result.path[depth - 1] = parent;
+                        result.pathMoves[depth - 1] = move;
+                        linked = true;
+                        break;
+                    }
+                }
+                if (linked) break;
+            }
+        }
+        return result;
+    }
+
+    std::string moveText(const Move& move, const int before[], const int after[]) const {
+        if (move.from == NO_JUG) return "Fill Jug " + std::to_string(move.to + 1) + " (" + std::to_string(config.capacity[move.to]) + "L)";
+        if (move.to == NO_JUG) return "Empty Jug " + std::to_string(move.from + 1);
+        return "Jug " + std::to_string(move.from + 1) + " -> Jug " + std::to_string(move.to + 1) +
+               " (" + std::to_string(before[move.from] - after[move.from]) + "L)";
+    }
+
+    std::string stateText(const int amount[]) const {
+        std::string text = "[";
+        for (int i = 0; i < jugs; i++) text += (i ? ", " : "") + std::to_string(amount[i]) + "L";
+        return text + "]";
+    }
+};
+
+int main() {
+    std::cout << "=== N-JUG WATER PROBLEM SOLVER ===\n\n";
+
+    NJugConfig config;
+    int jugs;
+    std::cout << "Enter number of jugs (1-" << MAX_JUGS << "): ";
+    std::cin >> jugs;
+    if (jugs < 1 || jugs > MAX_JUGS) {
+        std::cout << "Error: Number of jugs must be between 1 and " << MAX_JUGS << "!\n";
+        return 1;
+    }
+    config.capacity.resize(jugs);
+    config.initial.resize(jugs);
+    std::cout << "Enter the capacity of each jug: ";
+    for (int& capacity : config.capacity) std::cin >> capacity;
+    std::cout << "Enter the starting amount in each jug: ";
+    for (int i = 0; i < jugs; i++) {
+        std::cin >> config.initial[i];
+        if (config.initial[i] < 0 || config.initial[i] > config.capacity[i]) {
+            std::cout << "Error: Jug " << i + 1 << " cannot start with " << config.initial[i] << "L!\n";
+            return 1;
+        }
+    }
+
+    char choice;
+    std::cout << "Infinite source (jugs can be filled from a tap)? (y/n): ";
+    std::cin >> choice;
+    config.infiniteSource = (choice == 'y' || choice == 'Y');
+    std::cout << "Infinite sink (jugs can be emptied)? (y/n): ";
+    std::cin >> choice;
+    config.infiniteSink = (choice == 'y' || choice == 'Y');
+
+    std::cout << "Enter target amount: ";
+    std::cin >> config.target;
+    std::cout << "Goal: 1 = any single jug holds the target, 2 = all jugs together hold it: ";
+    int goal;
+    std::cin >> goal;
+    config.targetIsTotal = (goal == 2);
+
+    int threads;
+    std::cout << "Enter number of threads: ";
+    std::cin >> threads;
+    // More threads than cores only adds switching; hardware_concurrency() is 0 if unknown
+    unsigned cores = std::thread::hardware_concurrency();
+    threads = std::max(1, cores ? std::min(threads, (int)cores) : threads);
+
+    NJugSolver solver(config);
+    if (!solver.fitsIn64Bits()) {
+        std::cout << "Error: The state space of these jugs does not fit in a 64-bit rank!\n";
+        return 1;
+    }
+    std::cout << "\nState space: " << solver.stateCount() << " ranks ("
+              << (VisitedStates::denseFor(solver.stateCount()) ? "dense bitmap" : "hashed") << " visited set)\n";
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    NJugSolver::Result result = solver.solve(threads);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    std::cout << "Time taken: " << duration.count() << " ms on " << threads << " thread(s)\n";
+    std::cout << "States visited: " << result.statesVisited << " over " << result.levelSizes.size() << " levels\n";
+
+    if (!result.found) {
+        std::cout << "\nNo solution: the target cannot be reached from the starting amounts.\n";
+        return 0;
+    }
+
+    std::cout << "\n=== SOLUTION FOUND! ===\n";
+    std::cout << "\nSolution path (" << result.depth << " steps):\n";
+    std::cout << std::string(60, '-') << std::endl;
+    int before[MAX_JUGS], after[MAX_JUGS];
+    solver.decode(result.path[0], before);
+    std::cout << "Step 0: " << solver.stateText(before) << " [Initial state]\n";
+    for (int i = 1; i <= result.depth; i++) {
+        solver.decode(result.path[i], after);
+        std::cout << "Step " << i << ": " << solver.stateText(after) << " ["
+                  << solver.moveText(result.pathMoves[i - 1], before, after) << "]\n";
+        std::copy(after, after + jugs, before);
+    }
+    std::cout << " *** TARGET ACHIEVED ***\n";
+    std::cout << std::string(60, '-') << std::endl;
+    return 0;
+}
@@ -1,20 +1,35 @@
 #include <bits/stdc++.h>
 
-int nodes = 1;              // Global Variable to track the number of nodes generated
 const int MAX_DEPTH = 50;   // Maximum depth limit for the search algorithm
 
 enum SearchType {
     DFS = 1,
-    BFS = 2
+    BFS = 2,
+    NUMBER_THEORY = 3,
+    ALL_TARGETS = 4
 };
 
+const long long MAX_PRINTED_STEPS = 10000;      // Longer analytic solutions are summarised instead of listed
+const uint64_t MAX_CROSS_CHECK_CELLS = 1 << 22; // Largest (capacity1 + 1) x (capacity2 + 1) grid the BFS cross-check runs on
+
+// Action that produced a state; the text is only built when the solution path is printed
+enum Action : uint8_t {
+    INITIAL,
+    FILL_1,
+    FILL_2,
+    EMPTY_1,
+    EMPTY_2,
+    POUR_1_TO_2,
+    POUR_2_TO_1
+};
+
+// Plain 20-byte record: no strings, so generating a state never allocates
 struct State {
-    int id;
     int jug1;       // Current water in jug 1
     int jug2;       // Current water in jug 2
-    int parent;
+    int parent;     // Index of the parent in `states`, -1 for the initial state
     int depth;
-    std::string action; // Description of action taken to reach this state
+    uint8_t action; // Action taken to reach this state
 };
 
 struct JugConfig {
@@ -23,25 +38,119 @@ struct JugConfig {
     int target;     // Target amount to achieve
 };
 
-void GenMoves(State currState, std::deque<State> &container, std::unordered_set<std::string> &openSet, 
-              std::unordered_set<std::string>& closed, std::unordered_map<int, State> &stateMap, 
-              SearchType searchType, const JugConfig& config);
+// Every state reachable from (0, 0) has one jug empty or full, so there are at most
+// 2 * (capacity2 + 1) + 2 * (capacity1 + 1) of them
+uint64_t MaxReachableStates(int capacity1, int capacity2) {
+    return 2 * ((uint64_t)capacity1 + 1) + 2 * ((uint64_t)capacity2 + 1);
+}
+
+// States seen so far (open or closed). One bit per (jug1, jug2) pair in a dense
+// (capacity1 + 1) x (capacity2 + 1) grid while that grid is small or not much bigger than
+// the reachable states; otherwise (the grid grows with the product of the capacities,
+// the reachable states only with their sum) a hash set of packed keys.
+struct VisitedSet {
+    static constexpr uint64_t SMALL_GRID_BITS = 1ULL << 24;    // 2 MB: always dense
+    static constexpr uint64_t GRID_BITS_PER_STATE = 512;       // Up to 64 bytes of bitmap per reachable state
+
+    uint64_t columns;
+    std::vector<uint64_t> bits;
+    std::unordered_set<uint64_t> sparse;
+
+    explicit VisitedSet(const JugConfig& config) : columns((uint64_t)config.capacity2 + 1) {
+        uint64_t cells = ((uint64_t)config.capacity1 + 1) * columns;
+        uint64_t reachable = MaxReachableStates(config.capacity1, config.capacity2);
+        if (cells <= SMALL_GRID_BITS || cells <= reachable * GRID_BITS_PER_STATE) bits.assign((cells + 63) / 64, 0);
+    }
+
+    // Marks (jug1, jug2) as seen; returns false if it already was
+    bool insert(int jug1, int jug2) {
+        uint64_t cell = (uint64_t)jug1 * columns + jug2;
+        if (bits.empty()) return sparse.insert(cell).second;
+        uint64_t mask = 1ULL << (cell & 63);
+        if (bits[cell >> 6] & mask) return false;
+        bits[cell >> 6] |= mask;
+        return true;
+    }
+};
+
+// Result of one full BFS from (0, 0): every reachable state with its parent, and for every
+// amount the first state (in BFS order, so with the fewest steps) where a jug holds it
+struct TargetTable {
+    int capacity1;
+    int capacity2;
+    std::vector<State> states;      // In BFS order; parent indices point into this vector
+    std::vector<int> firstReach;    // firstReach[t] = index into states, -1 if t cannot be measured
+};
+
+void GenMoves(int currIndex, std::deque<int> &container, VisitedSet &visited,
+              std::vector<State> &states, const JugConfig& config);
 bool GoalTest(const State &currState, const JugConfig& config);
-std::string stateToString(const State& s);
+std::string actionText(const State& state, const State* parent, const JugConfig& config);
+long long extendedGcd(long long a, long long b, long long &x, long long &y);
+long long AnalyticSteps(long long a, long long b, long long t, long long &fills, long long &empties);
+int BFSSteps(const JugConfig& config);
+void SolveNumberTheory(const JugConfig& config);
+TargetTable BuildTargetTable(const JugConfig& config);
+bool SaveTargetTable(const TargetTable& table, const std::string& fileName);
+bool LoadTargetTable(const std::string& fileName, int capacity1, int capacity2, TargetTable& table);
+const TargetTable& GetTargetTable(const JugConfig& config);
+void PrintTablePath(const TargetTable& table, const JugConfig& config);
+void SolveAllTargets(JugConfig config);
 
-std::string stateToString(const State& s) {
-    return std::to_string(s.jug1) + "," + std::to_string(s.jug2);
+// Calls visit(jug1, jug2, action) for each of the six moves that changes the state
+template <typename Visit>
+void ForEachMove(int jug1, int jug2, const JugConfig& config, Visit visit) {
+    // Action 1: Fill Jug 1
+    if (jug1 < config.capacity1)
+        visit(config.capacity1, jug2, FILL_1);
+
+    // Action 2: Fill Jug 2
+    if (jug2 < config.capacity2)
+        visit(jug1, config.capacity2, FILL_2);
+
+    // Action 3: Empty Jug 1
+    if (jug1 > 0)
+        visit(0, jug2, EMPTY_1);
+
+    // Action 4: Empty Jug 2
+    if (jug2 > 0)
+        visit(jug1, 0, EMPTY_2);
+
+    // Action 5: Pour from Jug 1 to Jug 2
+    if (jug1 > 0 && jug2 < config.capacity2) {
+        int pourAmount = std::min(jug1, config.capacity2 - jug2);
+        visit(jug1 - pourAmount, jug2 + pourAmount, POUR_1_TO_2);
+    }
+
+    // Action 6: Pour from Jug 2 to Jug 1
+    if (jug2 > 0 && jug1 < config.capacity1) {
+        int pourAmount = std::min(jug2, config.capacity1 - jug1);
+        visit(jug1 + pourAmount, jug2 - pourAmount, POUR_2_TO_1);
+    }
 }
 
 bool GoalTest(const State &currState, const JugConfig& config) {
     return currState.jug1 == config.target || currState.jug2 == config.target;
 }
 
+// Describes the action that led from `parent` to `state`
+std::string actionText(const State& state, const State* parent, const JugConfig& config) {
+    switch (state.action) {
+        case FILL_1:      return "Fill Jug 1 (" + std::to_string(config.capacity1) + "L)";
+        case FILL_2:      return "Fill Jug 2 (" + std::to_string(config.capacity2) + "L)";
+        case EMPTY_1:     return "Empty Jug 1";
+        case EMPTY_2:     return "Empty Jug 2";
+        case POUR_1_TO_2: return "Jug 1 -> Jug 2 (" + std::to_string(parent->jug1 - state.jug1) + "L)";
+        case POUR_2_TO_1: return "Jug 2 -> Jug 1 (" + std::to_string(parent->jug2 - state.jug2) + "L)";
+        default:          return "Initial state (both jugs empty)";
+    }
+}
+
 int main() {
     std::cout << "=== WATER JUG PROBLEM SOLVER ===\n\n";
-    
+
     JugConfig config;
-    
+
     // Get problem configuration from user
     std::cout << "Enter capacity of Jug 1: ";
     std::cin >> config.capacity1;
@@ -49,25 +158,31 @@ int main() {
     std::cin >> config.capacity2;
     std::cout << "Enter target amount: ";
     std::cin >> config.target;
-    
+
     // Validate input
+    if (config.target < 0) {
+        std::cout << "Error: Target cannot be negative!\n";
+        return 1;
+    }
     if (config.target > std::max(config.capacity1, config.capacity2)) {
         std::cout << "Error: Target cannot be greater than the largest jug capacity!\n";
         return 1;
     }
-    
-    std::cout << "\nProblem: Find " << config.target << " liters using jugs of " 
+
+    std::cout << "\nProblem: Find " << config.target << " liters using jugs of "
               << config.capacity1 << "L and " << config.capacity2 << "L\n\n";
-    
+
     // Choose search algorithm
     SearchType searchType;
     int choice;
     std::cout << "Choose search algorithm:\n";
     std::cout << "1. Depth-First Search (DFS)\n";
     std::cout << "2. Breadth-First Search (BFS)\n";
-    std::cout << "Enter choice (1 or 2): ";
+    std::cout << "3. Number theory (gcd + extended Euclid, for huge capacities)\n";
+    std::cout << "4. All targets (one BFS per jug pair, cached in memory and on disk)\n";
+    std::cout << "Enter choice (1, 2, 3 or 4): ";
     std::cin >> choice;
-    
+
     switch(choice) {
         case 1:
             searchType = DFS;
@@ -77,62 +192,61 @@ int main() {
             searchType = BFS;
             std::cout << "Using Breadth-First Search (BFS)\n\n";
             break;
+        case 3:
+            std::cout << "Using number theory\n\n";
+            SolveNumberTheory(config);
+            return 0;
+        case 4:
+            std::cout << "Using the all-targets table\n\n";
+            SolveAllTargets(config);
+            return 0;
         default:
             searchType = DFS;
             std::cout << "Invalid choice. Using DFS by default.\n\n";
     }
 
     // Initialize starting state (both jugs empty)
-    State initialState;
-    initialState.id = 0;
-    initialState.jug1 = 0;
-    initialState.jug2 = 0;
-    initialState.parent = -1;
-    initialState.depth = 0;
-    initialState.action = "Initial state (both jugs empty)";
-
-    std::unordered_map<int, State> stateMap;    // Maps id to state. Useful to trace Path Taken by using parent's ID stored in the State
-    stateMap[initialState.id] = initialState;
-    
+    State initialState = {0, 0, -1, 0, INITIAL};
+
+    std::vector<State> states;      // Every generated state; its index is its id. Used to trace the path through `parent`
+    states.push_back(initialState);
+
     // Using deque to support both stack (DFS) and queue (BFS) operations
-    // Using container to track possible states
-    std::deque<State> container;
-    container.push_back(initialState);
-    
-    // Using unordered_set to track possible states
-    // This is a duplicate of container, but it allows for O(1) average time complexity for lookups
-    // Used in GenMoves() to spped up lookups
-    std::unordered_set<std::string> openSet;
-    openSet.insert(stateToString(initialState));
+    // Holds indices into `states` of the states still to be searched
+    std::deque<int> container;
+    container.push_back(0);
+
+    // Replaces the open and closed sets: a state is skipped once it has been generated
+    VisitedSet visited(config);
+    visited.insert(0, 0);
 
     bool solutionFound = false;
-    std::unordered_set<std::string> closed;
     int nodesExplored = 0;      // Counter for nodes explored
 
     auto start_time = std::chrono::high_resolution_clock::now();    // Start timer to measure search time
 
     while (!container.empty()) {
-        State currState;
-        
+        int currIndex;
+
         // DFS: take from back (stack behavior)
         if (searchType == DFS) {
-            currState = container.back();
+            currIndex = container.back();
             container.pop_back();
         }
         // BFS: take from front (queue behavior)
         else {
-            currState = container.front();
+            currIndex = container.front();
             container.pop_front();
         }
-        
-        openSet.erase(stateToString(currState));
+
+        const State currState = states[currIndex];
         nodesExplored++;
-        
+
         // Print progress every 100 nodes explored
         if (nodesExplored % 100 == 0) {
-            std::cout << "Nodes explored: " << nodesExplored 
-                      << ", Container size: " << container.size() 
-                      << ", Current depth: " << currState.depth 
+            std::cout << "Nodes explored: " << nodesExplored
+                      << ", Container size: " << container.size()
+                      << ", Current depth: " << currState.depth
                       << ", Current state: (" << currState.jug1 << "L, " << currState.jug2 << "L)\n";
         }
 
@@ -140,7 +254,7 @@ int main() {
             solutionFound = true;
             auto end_time = std::chrono::high_resolution_clock::now();      // End timer when solution is found
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-            
+
             std::cout << "\n=== SOLUTION FOUND! ===\n";
             std::cout << "Search Algorithm: " << (searchType == DFS ? "DFS" : "BFS") << std::endl;
             std::cout << "Time taken: " << duration.count() << " ms\n";
@@ -151,28 +265,23 @@ int main() {
             } else {
                 std::cout << "Jug 2\n";
             }
-            
-            std::vector<State> path;        // To reconstruct the path taken to reach the goal state
-            while (currState.parent != -1) {
-                path.push_back(currState);
-                currState = stateMap[currState.parent];
+
+            std::vector<int> path;          // Indices of the states on the path taken to reach the goal state
+            for (int index = currIndex; index != -1; index = states[index].parent) {
+                path.push_back(index);
             }
-            path.push_back(currState);
             std::reverse(path.begin(), path.end());
-            
+
             std::cout << "\nSolution path (" << path.size() - 1 << " steps):\n";
             std::cout << std::string(60, '-') << std::endl;
-            
+
             for (size_t i = 0; i < path.size(); ++i) {
-                const auto& state = path[i];
+                const auto& state = states[path[i]];
+                const State* parent = i > 0 ? &states[path[i - 1]] : nullptr;
                 std::cout << "Step " << i << ": ";
                 std::cout << "Jug1=" << state.jug1 << "L, Jug2=" << state.jug2 << "L";
-                if (i > 0) {
-                    std::cout << " [" << state.action << "]";
-                } else {
-                    std::cout << " [" << state.action << "]";
-                }
-                
+                std::cout << " [" << actionText(state, parent, config) << "]";
+
                 // Highlight target achievement
                 if (state.jug1 == config.target || state.jug2 == config.target) {
                     std::cout << '\n' << " *** TARGET ACHIEVED ***";
@@ -180,12 +289,11 @@ int main() {
                 std::cout << std::endl;
             }
             std::cout << std::string(60, '-') << std::endl;
-            
+
             break;
         }
 
-        closed.insert(stateToString(currState));
-        GenMoves(currState, container, openSet, closed, stateMap, searchType, config);
+        GenMoves(currIndex, container, visited, states, config);
     }
 
     if (!solutionFound) {
@@ -194,98 +302,334 @@ int main() {
         std::cout << "\nNo solution found within depth limit of " << MAX_DEPTH << "!\n";
         std::cout << "Time taken: " << duration.count() << " ms\n";
         std::cout << "Nodes explored: " << nodesExplored << std::endl;
-        
+
         // Check if solution is theoretically possible
         int gcd_val = std::__gcd(config.capacity1, config.capacity2);
         if (config.target % gcd_val != 0) {
             std::cout << "\nNote: This problem has no solution!\n";
-            std::cout << "Target " << config.target << " is not achievable with jugs of capacity " 
+            std::cout << "Target " << config.target << " is not achievable with jugs of capacity "
                       << config.capacity1 << " and " << config.capacity2 << std::endl;
-            std::cout << "For a solution to exist, target must be divisible by GCD(" 
+            std::cout << "For a solution to exist, target must be divisible by GCD("
                       << config.capacity1 << ", " << config.capacity2 << ") = " << gcd_val << std::endl;
         } else {
             std::cout << "\nSolution should exist but wasn't found within depth limit. Try increasing MAX_DEPTH.\n";
         }
     }
-    
+
     return 0;
 }
 
-void GenMoves(State currState, std::deque<State> &container, std::unordered_set<std::string> &openSet, 
-              std::unordered_set<std::string>& closed, std::unordered_map<int, State> &stateMap, 
-              SearchType searchType, const JugConfig& config) {
+void GenMoves(int currIndex, std::deque<int> &container, VisitedSet &visited,
+              std::vector<State> &states, const JugConfig& config) {
     // Generate possible moves from the current state
+    const State currState = states[currIndex];      // Copy: push_back below may reallocate `states`
 
     if (currState.depth >= MAX_DEPTH) return;       // Skip if we've reached maximum depth (applies to both DFS and BFS)
-    
-    std::vector<State> possibleMoves;
-    
-    // Action 1: Fill Jug 1
-    if (currState.jug1 < config.capacity1) {
-        State next = currState;
-        next.jug1 = config.capacity1;
-        next.action = "Fill Jug 1 (" + std::to_string(config.capacity1) + "L)";
-        possibleMoves.push_back(next);
+
+    // Adds a successor unless it was already generated
+    // DFS: add to back (stack behavior)
+    // BFS: add to back, but we take from front (queue behavior)
+    ForEachMove(currState.jug1, currState.jug2, config, [&](int jug1, int jug2, Action action) {
+        if (!visited.insert(jug1, jug2)) return;
+        states.push_back({jug1, jug2, currIndex, currState.depth + 1, action});
+        container.push_back((int)states.size() - 1);
+    });
+}
+
+// Returns gcd(a, b) and sets x, y so that a * x + b * y = gcd(a, b)
+long long extendedGcd(long long a, long long b, long long &x, long long &y) {
+    if (b == 0) {
+        x = 1;
+        y = 0;
+        return a;
     }
-    
-    // Action 2: Fill Jug 2
-    if (currState.jug2 < config.capacity2) {
-        State next = currState;
-        next.jug2 = config.capacity2;
-        next.action = "Fill Jug 2 (" + std::to_string(config.capacity2) + "L)";
-        possibleMoves.push_back(next);
+    long long x1, y1;
+    long long g = extendedGcd(b, a % b, x1, y1);
+    x = y1;
+    y = x1 - (a / b) * y1;
+    return g;
+}
+
+// Steps taken by the strategy "fill jug A, pour A into B, empty B when full" until one
+// jug holds t (a, b = capacities of A and B; t must be a multiple of gcd(a, b)).
+// Every pour follows a fill of A or an emptying of B, so steps = 2 * (fills + empties).
+// The last fill is the first x >= 1 with x * a = t (mod b), found with extended Euclid,
+// and the water moved then decides how many times B was emptied.
+long long AnalyticSteps(long long a, long long b, long long t, long long &fills, long long &empties) {
+    fills = empties = 0;
+    if (t == 0) return 0;
+    if (t == a) {
+        fills = 1;
+        return 1;
     }
-    
-    // Action 3: Empty Jug 1
-    if (currState.jug1 > 0) {
-        State next = currState;
-        next.jug1 = 0;
-        next.action = "Empty Jug 1";
-        possibleMoves.push_back(next);
+    if (a == 0 || b == 0) return LLONG_MAX;     // Pouring from A can only ever give 0 or a
+    if (t == b) {                               // B is full for the first time
+        fills = (b + a - 1) / a;
+        return 2 * fills;
     }
-    
-    // Action 4: Empty Jug 2
-    if (currState.jug2 > 0) {
-        State next = currState;
-        next.jug2 = 0;
-        next.action = "Empty Jug 2";
-        possibleMoves.push_back(next);
+
+    long long inverse, unused;
+    long long g = extendedGcd(a, b, inverse, unused);
+    long long bReduced = b / g;
+    long long x = ((t / g) % bReduced) * (((inverse % bReduced) + bReduced) % bReduced) % bReduced;
+    if (x == 0) x = bReduced;
+
+    long long emptied = (x * a - t) / b;
+    fills = x;
+    // t left in A right after B fills (one emptying fewer), else t poured into an empty B
+    empties = emptied >= 1 && t < a ? emptied - 1 : emptied;
+    return 2 * (fills + empties);
+}
+
+// Minimum number of steps by BFS without a depth limit, -1 if the target is unreachable
+int BFSSteps(const JugConfig& config) {
+    VisitedSet visited(config);
+    std::vector<std::pair<int, int>> level = {{0, 0}}, nextLevel;
+    visited.insert(0, 0);
+    for (int depth = 0; !level.empty(); depth++) {
+        for (const auto& jugs : level) {
+            if (jugs.first == config.target || jugs.second == config.target) return depth;
+            ForEachMove(jugs.first, jugs.second, config, [&](int jug1, int jug2, Action) {
+                if (visited.insert(jug1, jug2)) nextLevel.push_back({jug1, jug2});
+            });
+        }
+        level.swap(nextLevel);
+        nextLevel.clear();
     }
-    
-    // Action 5: Pour from Jug 1 to Jug 2
-    if (currState.jug1 > 0 && currState.jug2 < config.capacity2) {
-        State next = currState;
-        int pourAmount = std::min(currState.jug1, config.capacity2 - currState.jug2);
-        next.jug1 -= pourAmount;
-        next.jug2 += pourAmount;
-        next.action = "Jug 1 -> Jug 2 (" + std::to_string(pourAmount) + "L)";
-        possibleMoves.push_back(next);
+    return -1;
+}
+
+// Decides feasibility with gcd, takes the shorter of the two pour directions (computed in
+// O(log capacity)) and prints its moves by simulation in O(steps) time and O(1) memory
+void SolveNumberTheory(const JugConfig& config) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    long long x, y;
+    long long g = extendedGcd(config.capacity1, config.capacity2, x, y);
+    std::cout << "GCD(" << config.capacity1 << ", " << config.capacity2 << ") = " << g
+              << " = " << config.capacity1 << " * " << x << " + " << config.capacity2 << " * " << y << "\n";
+    if (g == 0 ? config.target != 0 : config.target % g != 0) {
+        std::cout << "\nNote: This problem has no solution!\n";
+        std::cout << "For a solution to exist, target must be divisible by GCD("
+                  << config.capacity1 << ", " << config.capacity2 << ") = " << g << std::endl;
+        return;
     }
-    
-    // Action 6: Pour from Jug 2 to Jug 1
-    if (currState.jug2 > 0 && currState.jug1 < config.capacity1) {
-        State next = currState;
-        int pourAmount = std::min(currState.jug2, config.capacity1 - currState.jug1);
-        next.jug2 -= pourAmount;
-        next.jug1 += pourAmount;
-        next.action = "Jug 2 -> Jug 1 (" + std::to_string(pourAmount) + "L)";
-        possibleMoves.push_back(next);
+
+    long long fills[2], empties[2];
+    long long steps1 = AnalyticSteps(config.capacity1, config.capacity2, config.target, fills[0], empties[0]);
+    long long steps2 = AnalyticSteps(config.capacity2, config.capacity1, config.target, fills[1], empties[1]);
+    int from = steps1 <= steps2 ? 0 : 1;       // Jug that is filled (0 = Jug 1)
+    long long steps = std::min(steps1, steps2);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    std::cout << "\n=== SOLUTION FOUND! ===\n";
+    std::cout << "Time taken: " << duration.count() << " us\n";
+    auto stepsText = [](long long count) {
+        return count == LLONG_MAX ? std::string("never reaches the target") : "takes " + std::to_string(count) + " steps";
+    };
+    std::cout << "Pouring from Jug 1 into Jug 2 " << stepsText(steps1) << ", from Jug 2 into Jug 1 "
+              << stepsText(steps2) << "\n";
+    std::cout << "Fill Jug " << from + 1 << " " << fills[from] << " times and empty Jug " << 2 - from << " "
+              << empties[from] << " times (" << steps << " steps)\n";
+
+    if (steps > MAX_PRINTED_STEPS) {
+        std::cout << "Solution path has more than " << MAX_PRINTED_STEPS << " steps; not printed\n";
+    } else {
+        // Simulate the chosen direction, printing each step as it is made
+        int capacity[2] = {config.capacity1, config.capacity2};
+        int to = 1 - from;
+        State prev = {0, 0, -1, 0, INITIAL};
+        std::cout << "\nSolution path (" << steps << " steps):\n";
+        std::cout << std::string(60, '-') << std::endl;
+        std::cout << "Step 0: Jug1=0L, Jug2=0L [" << actionText(prev, nullptr, config) << "]\n";
+        for (long long i = 1; prev.jug1 != config.target && prev.jug2 != config.target; i++) {
+            int jugs[2] = {prev.jug1, prev.jug2};
+            State next = prev;
+            if (jugs[from] == 0) {
+                jugs[from] = capacity[from];
+                next.action = from == 0 ? FILL_1 : FILL_2;
+            } else if (jugs[to] == capacity[to]) {
+                jugs[to] = 0;
+                next.action = to == 0 ? EMPTY_1 : EMPTY_2;
+            } else {
+                int pourAmount = std::min(jugs[from], capacity[to] - jugs[to]);
+                jugs[from] -= pourAmount;
+                jugs[to] += pourAmount;
+                next.action = from == 0 ? POUR_1_TO_2 : POUR_2_TO_1;
+            }
+            next.jug1 = jugs[0];
+            next.jug2 = jugs[1];
+            std::cout << "Step " << i << ": Jug1=" << next.jug1 << "L, Jug2=" << next.jug2 << "L ["
+                      << actionText(next, &prev, config) << "]";
+            if (next.jug1 == config.target || next.jug2 == config.target) {
+                std::cout << '\n' << " *** TARGET ACHIEVED ***";
+            }
+            std::cout << '\n';
+            prev = next;
+        }
+        std::cout << std::string(60, '-') << std::endl;
+    }
+
+    // Cross-check against a full BFS when the state grid is small enough
+    if (((uint64_t)config.capacity1 + 1) * ((uint64_t)config.capacity2 + 1) <= MAX_CROSS_CHECK_CELLS) {
+        int bfsSteps = BFSSteps(config);
+        std::cout << "BFS cross-check: " << bfsSteps << " steps (" << (bfsSteps == steps ? "match" : "MISMATCH") << ")\n";
+    }
+}
+
+// One BFS from (0, 0) without a depth limit. The states vector doubles as the queue, and
+// the first time an amount appears in either jug is recorded for that amount.
+TargetTable BuildTargetTable(const JugConfig& config) {
+    TargetTable table;
+    table.capacity1 = config.capacity1;
+    table.capacity2 = config.capacity2;
+    table.firstReach.assign(std::max(config.capacity1, config.capacity2) + 1, -1);
+    table.states.push_back({0, 0, -1, 0, INITIAL});
+    table.firstReach[0] = 0;
+
+    VisitedSet visited(config);
+    visited.insert(0, 0);
+    for (size_t head = 0; head < table.states.size(); head++) {
+        const State currState = table.states[head];
+        ForEachMove(currState.jug1, currState.jug2, config, [&](int jug1, int jug2, Action action) {
+            if (!visited.insert(jug1, jug2)) return;
+            int index = (int)table.states.size();
+            table.states.push_back({jug1, jug2, (int)head, currState.depth + 1, action});
+            if (table.firstReach[jug1] == -1) table.firstReach[jug1] = index;
+            if (table.firstReach[jug2] == -1) table.firstReach[jug2] = index;
+        });
+    }
+    return table;
+}
+
+// File layout: "WJTB", capacity1, capacity2, state count, then per state jug1, jug2,
+// parent, depth (int32) and action (1 byte), then the firstReach array (int32)
+bool SaveTargetTable(const TargetTable& table, const std::string& fileName) {
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out) return false;
+    auto writeInt = [&out](int32_t value) { out.write((const char*)&value, sizeof(value)); };
+    out.write("WJTB", 4);
+    writeInt(table.capacity1);
+    writeInt(table.capacity2);
+    writeInt((int32_t)table.states.size());
+    for (const State& state : table.states) {
+        writeInt(state.jug1);
+        writeInt(state.jug2);
+        writeInt(state.parent);
+        writeInt(state.depth);
+        out.put((char)state.action);
+    }
+    for (int index : table.firstReach) writeInt(index);
+    return (bool)out;
+}
+
+bool LoadTargetTable(const std::string& fileName, int capacity1, int capacity2, TargetTable& table) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) return false;
+    auto readInt = [&in]() {
+        int32_t value = 0;
+        in.read((char*)&value, sizeof(value));
+        return value;
+    };
+    char magic[4];
+    in.read(magic, 4);
+    if (!in || std::string(magic, 4) != "WJTB") return false;
+    table.capacity1 = readInt();
+    table.capacity2 = readInt();
+    int32_t count = readInt();
+    if (!in || table.capacity1 != capacity1 || table.capacity2 != capacity2) return false;
+
+    // A stale or truncated file is treated like a missing one: every index must stay in range
+    // and each state must sit one step below its parent
+    if (count < 1 || (uint64_t)count > MaxReachableStates(capacity1, capacity2)) return false;
+    table.states.resize(count);
+    for (int32_t i = 0; i < count; i++) {
+        State& state = table.states[i];
+        state.jug1 = readInt();
+        state.jug2 = readInt();
+        state.parent = readInt();
+        state.depth = readInt();
+        state.action = (uint8_t)in.get();
+        if (!in || state.jug1 < 0 || state.jug1 > capacity1 || state.jug2 < 0 || state.jug2 > capacity2 ||
+            state.action > POUR_2_TO_1) return false;
+        if (i == 0 ? state.parent != -1 || state.depth != 0
+                   : state.parent < 0 || state.parent >= i || state.depth != table.states[state.parent].depth + 1) return false;
+    }
+    table.firstReach.resize(std::max(capacity1, capacity2) + 1);
+    for (int& index : table.firstReach) {
+        index = readInt();
+        if (index < -1 || index >= count) return false;
     }
-    
-    // Process all possible moves
-    for (auto& next : possibleMoves) {
-        next.parent = currState.id;
-        next.id = nodes++;
-        next.depth = currState.depth + 1;
-        
-        std::string key = stateToString(next);
-        
-        if (openSet.find(key) == openSet.end() && closed.find(key) == closed.end()) {
-            stateMap[next.id] = next;
-            // DFS: add to back (stack behavior)
-            // BFS: add to back, but we take from front (queue behavior)
-            container.push_back(next);
-            openSet.insert(key);
+    return (bool)in;
+}
+
+// Table for the jug pair of `config`: from memory if this run already built it, else from
+// "waterjug_<capacity1>x<capacity2>.tbl" if present, else built by BFS and saved there
+const TargetTable& GetTargetTable(const JugConfig& config) {
+    static std::map<std::pair<int, int>, TargetTable> cache;
+    auto key = std::make_pair(config.capacity1, config.capacity2);
+    auto cached = cache.find(key);
+    if (cached != cache.end()) return cached->second;
+
+    std::string fileName = "waterjug_" + std::to_string(config.capacity1) + "x" + std::to_string(config.capacity2) + ".tbl";
+    TargetTable table;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    bool loaded = LoadTargetTable(fileName, config.capacity1, config.capacity2, table);
+    if (!loaded) table = BuildTargetTable(config);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    std::cout << (loaded ? "Loaded " : "Built ") << fileName << " in " << duration.count() << " ms ("
+              << table.states.size() << " reachable states)\n";
+    if (!loaded && !SaveTargetTable(table, fileName)) std::cout << "Could not write " << fileName << "\n";
+    return cache.emplace(key, std::move(table)).first->second;
+}
+
+// Prints the shortest path to config.target by following parent indices from its first state
+void PrintTablePath(const TargetTable& table, const JugConfig& config) {
+    int goal = table.firstReach[config.target];
+    if (goal == -1) {
+        std::cout << "Target " << config.target << "L cannot be measured with these jugs\n";
+        return;
+    }
+
+    std::vector<int> path;
+    for (int index = goal; index != -1; index = table.states[index].parent) {
+        path.push_back(index);
+    }
+    std::reverse(path.begin(), path.end());
+
+    std::cout << "\nSolution path (" << path.size() - 1 << " steps):\n";
+    std::cout << std::string(60, '-') << std::endl;
+    for (size_t i = 0; i < path.size(); ++i) {
+        const State& state = table.states[path[i]];
+        const State* parent = i > 0 ? &table.states[path[i - 1]] : nullptr;
+        std::cout << "Step " << i << ": Jug1=" << state.jug1 << "L, Jug2=" << state.jug2 << "L ["
+                  << actionText(state, parent, config) << "]";
+        if (state.jug1 == config.target || state.jug2 == config.target) {
+            std::cout << '\n' << " *** TARGET ACHIEVED ***";
         }
+        std::cout << std::endl;
     }
-}
\ No newline at end of file
+    std::cout << std::string(60, '-') << std::endl;
+}
+
+// Answers the first target, then any number of further targets for the same jugs from the table
+void SolveAllTargets(JugConfig config) {
+    const TargetTable& table = GetTargetTable(config);
+    int measurable = 0;
+    for (int index : table.firstReach) measurable += index != -1;
+    std::cout << measurable << " of " << table.firstReach.size() << " amounts (0-"
+              << table.firstReach.size() - 1 << "L) can be measured\n";
+
+    while (true) {
+        PrintTablePath(table, config);
+        std::cout << "\nEnter another target amount (-1 to quit): ";
+        if (!(std::cin >> config.target) || config.target < 0) break;
+        while (config.target >= (int)table.firstReach.size()) {
+            std::cout << "Error: Target cannot be greater than the largest jug capacity!\n";
+            std::cout << "Enter another target amount (-1 to quit): ";
+            if (!(std::cin >> config.target) || config.target < 0) return;
+        }
+    }
+}
@@ -1,4 +1,7 @@
 #include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 struct State {
     int id;
@@ -12,46 +15,315 @@ struct State {
     State() : id(0), pos(0), parent(-1), depth(0), gCost(0), hCost(0), fCost(0) {}
 };
 
+// Progress report passed to the caller's callback instead of printing from the search loop
+struct SearchProgress {
+    int nodesExplored;
+    size_t openSize;
+    int currentF;       // f-cost of the node just expanded
+    int bestCost;       // Cost of the best path found so far (-1 if none yet)
+    double epsilon;     // Current suboptimality bound (1 for plain A*)
+    double elapsedMs;
+};
+
+using ProgressCallback = std::function<void(const SearchProgress&)>;
+
+// Result of an anytime search: the best path found before the deadline
+struct AnytimeResult {
+    std::vector<int> path;  // Empty if no path was found in time
+    int cost;
+    double epsilon;         // path cost <= epsilon * optimal cost
+    bool connected;         // False if start and goal are in different components (no search ran)
+};
+
+// Dial's bucket queue: one bucket per f-cost, used circularly.
+// With integer move costs and a consistent heuristic, every f-cost in the queue lies in
+// [minF, minF + span), so `span` buckets are enough and push/pop are O(1) amortised.
+// Within a bucket states are popped LIFO, which favours deeper nodes on f-cost ties.
+class BucketQueue {
+private:
+    std::vector<std::vector<State>> buckets;
+    int minF;
+    size_t count;
+
+public:
+    BucketQueue() : minF(0), count(0) {}
+
+    void reset(int span) {
+        buckets.assign(span, {});
+        minF = 0;
+        count = 0;
+    }
+
+    void push(const State& s) {
+        if (count == 0 || s.fCost < minF) minF = s.fCost;
+        buckets[s.fCost % buckets.size()].push_back(s);
+        count++;
+    }
+
+    State pop() {
+        while (buckets[minF % buckets.size()].empty()) minF++;
+        std::vector<State>& bucket = buckets[minF % buckets.size()];
+        State s = bucket.back();
+        bucket.pop_back();
+        count--;
+        return s;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+};
+
 class AStar {
 private:
-    std::vector<std::vector<int>> maze;
     int rows, cols;
+    
+    // Grid storage. Cells are addressed by a layout index (see posToIndex): plain
+    // row-major, or 16x16 tiles stored contiguously so that vertical neighbours on wide
+    // maps share cache lines and pages. `cells`, `bestG`, `closed` and every other
+    // per-cell array use the same index, so they are tiled too.
+    static const int TILE_SHIFT = 4;
+    static const int TILE = 1 << TILE_SHIFT;
+    bool tiled;
+    int tilesPerRow;
+    int gridSize;               // Number of layout slots (tiled grids are padded to whole tiles)
+    std::vector<int> cells;     // Cell values in layout order, padding = -1
     int startPos, goalPos;
     int nodeCounter;
     
-    // Priority queue comparator for A* (lower f-cost has higher priority)
-    struct Compare {
-        bool operator()(const State& a, const State& b) const {
-            if (a.fCost != b.fCost) return a.fCost > b.fCost;
-            return a.hCost > b.hCost; // Tie-breaker: prefer lower h-cost
-        }
-    };
+    // Multi-source / multi-goal search: every start is seeded at g = 0 and the
+    // search stops at the first goal popped. The heuristic is the minimum over goals
+    // while there are few of them, and 0 (plain Dijkstra) beyond MAX_HEURISTIC_GOALS.
+    static const int MAX_HEURISTIC_GOALS = 32;
+    std::vector<int> startList, goalList;
+    std::vector<char> goalCell;
     
-    std::priority_queue<State, std::vector<State>, Compare> openList;
-    std::unordered_set<int> openSet;
-    std::unordered_set<int> closedSet;
+    // Terrain: 0 = open (cost 1), >0 = cost of entering the cell, -1 = blocked
+    int minCellCost, maxCellCost;
+    bool terrainDirty;
+    
+    BucketQueue openList;
+    std::vector<int> bestG;                 // Cheapest g-cost seen per cell (layout index)
+    std::vector<char> closed;               // Expanded cells (layout index)
     std::unordered_map<int, State> allStates;
     
+    ProgressCallback progressCallback;
+    static const int PROGRESS_INTERVAL = 100;   // Nodes between progress reports
+    
+    // Goal-rooted distance fields, cached per goal cell with an LRU cap
+    size_t fieldCacheCapacity;
+    std::list<int> fieldLru;    // Most recently used goal at the front
+    std::unordered_map<int, std::pair<std::vector<int>, std::list<int>::iterator>> fieldCache;
+    
+    // Bit-parallel BFS: open cells as row bitsets (bit c of word w = column 64*w + c)
+    int rowWords;
+    std::vector<uint64_t> openBits;
+    
+    void buildOpenBits() {
+        rowWords = (cols + 63) / 64;
+        openBits.assign(rows * rowWords, 0);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                if (cellAt(i, j) != -1) openBits[i * rowWords + j / 64] |= 1ULL << (j % 64);
+    }
+    
+    // Cells of word w in row r reachable in one step from `frontier` (before masking)
+    uint64_t spreadWord(const std::vector<uint64_t>& frontier, int r, int w) {
+        const uint64_t* row = &frontier[r * rowWords];
+        uint64_t f = row[w];
+        uint64_t fromLeft = (f << 1) | (w > 0 ? row[w - 1] >> 63 : 0);
+        uint64_t fromRight = (f >> 1) | (w + 1 < rowWords ? row[w + 1] << 63 : 0);
+        uint64_t fromAbove = r > 0 ? frontier[(r - 1) * rowWords + w] : 0;
+        uint64_t fromBelow = r + 1 < rows ? frontier[(r + 1) * rowWords + w] : 0;
+        return fromLeft | fromRight | fromAbove | fromBelow;
+    }
+    
+    // Computes next = spread(frontier) & open & ~visited for rows [rLo, rHi]
+    void expandRows(const std::vector<uint64_t>& frontier, const std::vector<uint64_t>& visited,
+                    std::vector<uint64_t>& next, int rLo, int rHi) {
+        for (int r = rLo; r <= rHi; r++) {
+            int base = r * rowWords;
+            int w = 0;
+#ifdef __AVX2__
+            // Interior words four at a time; the carries come from unaligned loads at w-1 and w+1
+            if (rowWords >= 6) {
+                w = 1;
+                for (; w + 4 < rowWords; w += 4) {
+                    const __m256i* at = reinterpret_cast<const __m256i*>(&frontier[base + w]);
+                    __m256i f = _mm256_loadu_si256(at);
+                    __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&frontier[base + w - 1]));
+                    __m256i nxt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&frontier[base + w + 1]));
+                    __m256i spread = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_slli_epi64(f, 1), _mm256_srli_epi64(prev, 63)),
+                        _mm256_or_si256(_mm256_srli_epi64(f, 1), _mm256_slli_epi64(nxt, 63)));
+                    if (r > 0)
+                        spread = _mm256_or_si256(spread, _mm256_loadu_si256(
+                            reinterpret_cast<const __m256i*>(&frontier[base - rowWords + w])));
+                    if (r + 1 < rows)
+                        spread = _mm256_or_si256(spread, _mm256_loadu_si256(
+                            reinterpret_cast<const __m256i*>(&frontier[base + rowWords + w])));
+                    __m256i open = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&openBits[base + w]));
+                    __m256i seen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&visited[base + w]));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&next[base + w]),
+                                        _mm256_andnot_si256(seen, _mm256_and_si256(spread, open)));
+                }
+                next[base] = spreadWord(frontier, r, 0) & openBits[base] & ~visited[base];
+            }
+#endif
+            for (; w < rowWords; w++) {
+                next[base + w] = spreadWord(frontier, r, w) & openBits[base + w] & ~visited[base + w];
+            }
+        }
+    }
+    
+    int cellCost(int row, int col) {
+        return std::max(1, cellAt(row, col));
+    }
+    
+    void updateTerrainBounds() {
+        minCellCost = INT_MAX;
+        maxCellCost = 1;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (cellAt(i, j) == -1) continue;
+                minCellCost = std::min(minCellCost, cellCost(i, j));
+                maxCellCost = std::max(maxCellCost, cellCost(i, j));
+            }
+        }
+        if (minCellCost == INT_MAX) minCellCost = 1;
+        terrainDirty = false;
+    }
+    
+    // Connected-component labelling (union-find over open cells, 4-connected)
+    // Lets solve() reject unreachable goals without flooding the whole region
+    std::vector<int> componentParent;
+    bool componentsDirty;
+    
+    int findComponent(int index) {
+        while (componentParent[index] != index) {
+            componentParent[index] = componentParent[componentParent[index]];  // Path halving
+            index = componentParent[index];
+        }
+        return index;
+    }
+    
+    void unionComponents(int a, int b) {
+        int rootA = findComponent(a), rootB = findComponent(b);
+        if (rootA != rootB) componentParent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+    }
+    
+    // Joins a newly opened cell with all of its open neighbours
+    void linkWithNeighbours(int row, int col) {
+        const std::pair<int, int> neighbours[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        for (const auto& [dr, dc] : neighbours) {
+            if (isValid(row + dr, col + dc)) {
+                unionComponents(posToIndex(row, col), posToIndex(row + dr, col + dc));
+            }
+        }
+    }
+    
+    // One pass over the grid: every open cell is merged with its right and down neighbours
+    void buildComponents() {
+        componentParent.resize(gridSize);
+        for (int i = 0; i < gridSize; i++) componentParent[i] = i;
+        
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (cellAt(i, j) == -1) continue;
+                if (isValid(i + 1, j)) unionComponents(posToIndex(i, j), posToIndex(i + 1, j));
+                if (isValid(i, j + 1)) unionComponents(posToIndex(i, j), posToIndex(i, j + 1));
+            }
+        }
+        componentsDirty = false;
+    }
+    
 public:
-    AStar(const std::vector<std::vector<int>>& inputMaze) 
-        : maze(inputMaze), rows(inputMaze.size()), cols(inputMaze[0].size()), nodeCounter(1) {}
+    AStar(const std::vector<std::vector<int>>& inputMaze, size_t fieldCacheSize = 16, bool tiledLayout = false) 
+        : rows(inputMaze.size()), cols(inputMaze[0].size()), tiled(tiledLayout), nodeCounter(1),
+          fieldCacheCapacity(fieldCacheSize) {
+        tilesPerRow = (cols + TILE - 1) / TILE;
+        gridSize = tiled ? ((rows + TILE - 1) / TILE) * tilesPerRow * TILE * TILE : rows * cols;
+        cells.assign(gridSize, -1);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                cells[posToIndex(i, j)] = inputMaze[i][j];
+        
+        buildComponents();
+        updateTerrainBounds();
+        buildOpenBits();
+    }
+    
+    // Changes a cell and keeps the component labels up to date.
+    // Opening a cell only merges regions (done in place); blocking a cell may split
+    // a region, which union-find cannot undo, so the labels are rebuilt on next query.
+    void setCell(int row, int col, int value) {
+        bool wasOpen = cellAt(row, col) != -1;
+        cells[posToIndex(row, col)] = value;
+        bool isOpen = value != -1;
+        terrainDirty = true;
+        fieldCache.clear();     // Any cached distance field may now be wrong
+        fieldLru.clear();
+        
+        uint64_t bit = 1ULL << (col % 64);
+        if (isOpen) openBits[row * rowWords + col / 64] |= bit;
+        else openBits[row * rowWords + col / 64] &= ~bit;
+        
+        if (!wasOpen && isOpen) {
+            if (!componentsDirty) linkWithNeighbours(row, col);
+        } else if (wasOpen && !isOpen) {
+            componentsDirty = true;
+        }
+    }
+    
+    // Called every PROGRESS_INTERVAL expansions (and on each improved anytime solution)
+    void setProgressCallback(ProgressCallback callback) {
+        progressCallback = std::move(callback);
+    }
+    
+    // O(1) (amortised) check whether two open cells lie in the same region
+    bool sameComponent(int pos1, int pos2) {
+        return findComponentOf(pos1) == findComponentOf(pos2);
+    }
+    
+    int findComponentOf(int pos) {
+        if (componentsDirty) buildComponents();
+        return findComponent(pos);
+    }
+    
+    // Admissible heuristic: every step costs at least 10 * minCellCost
+    int heuristic(int pos) {
+        if ((int)goalList.size() > MAX_HEURISTIC_GOALS) return 0;
+        int best = INT_MAX;
+        for (int goal : goalList) best = std::min(best, manhattan(pos, goal));
+        return best * 10 * minCellCost;
+    }
     
     int manhattan(int pos1, int pos2) {
-        int r1 = pos1 / cols, c1 = pos1 % cols;
-        int r2 = pos2 / cols, c2 = pos2 % cols;
+        auto [r1, c1] = indexToPos(pos1);
+        auto [r2, c2] = indexToPos(pos2);
         return abs(r1 - r2) + abs(c1 - c2);
     }
     
     bool isValid(int row, int col) {
-        return row >= 0 && row < rows && col >= 0 && col < cols && maze[row][col] != -1;
+        return row >= 0 && row < rows && col >= 0 && col < cols && cells[posToIndex(row, col)] != -1;
     }
     
+    int cellAt(int row, int col) {
+        return cells[posToIndex(row, col)];
+    }
+    
+    // Layout index of a cell: row * cols + col, or (tile, row in tile, col in tile) when tiled
     int posToIndex(int row, int col) {
-        return row * cols + col;
+        if (!tiled) return row * cols + col;
+        int tile = (row >> TILE_SHIFT) * tilesPerRow + (col >> TILE_SHIFT);
+        return (tile << (2 * TILE_SHIFT)) | ((row & (TILE - 1)) << TILE_SHIFT) | (col & (TILE - 1));
     }
     
     std::pair<int, int> indexToPos(int index) {
-        return {index / cols, index % cols};
+        if (!tiled) return {index / cols, index % cols};
+        int tile = index >> (2 * TILE_SHIFT);
+        int within = index & (TILE * TILE - 1);
+        return {(tile / tilesPerRow) * TILE + (within >> TILE_SHIFT),
+                (tile % tilesPerRow) * TILE + (within & (TILE - 1))};
     }
     
     std::vector<State> generateSuccessors(const State& current) {
@@ -77,8 +349,8 @@ public:
                 
                 // Cost calculation
                 int moveCost = (abs(dr) + abs(dc) == 2) ? 14 : 10; // Diagonal = 14, Cardinal = 10
-                successor.gCost = current.gCost + moveCost;
-                successor.hCost = manhattan(successor.pos, goalPos) * 10;
+                successor.gCost = current.gCost + moveCost * cellCost(newRow, newCol);
+                successor.hCost = heuristic(successor.pos);
                 successor.fCost = successor.gCost + successor.hCost;
                 
                 successors.push_back(successor);
@@ -108,8 +380,11 @@ public:
         // Fill the display maze
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                if (maze[i][j] == -1) {
+                int value = cellAt(i, j);
+                if (value == -1) {
                     display[i][j] = '#';  // Blocked
+                } else if (value > 0) {
+                    display[i][j] = value < 10 ? '0' + value : '+';  // Terrain cost
                 } else {
                     display[i][j] = '.';  // Open
                 }
@@ -122,15 +397,19 @@ public:
             display[row][col] = '*';
         }
         
-        // Mark start and goal
-        auto [startRow, startCol] = indexToPos(startPos);
-        auto [goalRow, goalCol] = indexToPos(goalPos);
-        display[startRow][startCol] = 'S';
-        display[goalRow][goalCol] = 'G';
+        // Mark starts and goals
+        for (int pos : startList) {
+            auto [row, col] = indexToPos(pos);
+            display[row][col] = 'S';
+        }
+        for (int pos : goalList) {
+            auto [row, col] = indexToPos(pos);
+            display[row][col] = 'G';
+        }
         
         // Print the maze
         std::cout << "\nMaze with solution path:\n";
-        std::cout << "S = Start, G = Goal, * = Path, # = Blocked, . = Open\n\n";
+        std::cout << "S = Start, G = Goal, * = Path, # = Blocked, . = Open, 1-9/+ = Terrain cost\n\n";
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
                 std::cout << display[i][j] << " ";
@@ -139,42 +418,285 @@ public:
         }
     }
     
-    bool solve(int start, int goal) {
+    // Bit-parallel wavefront BFS (4-connected, unit cost).
+    // The frontier is a set of row bitsets; each layer expands 64 cells per word with
+    // shifts and masks instead of one State per cell. Returns the BFS layer of every
+    // cell (-1 if unreached); stops after the layer that reaches `goal` (-1 = full field).
+    std::vector<int> bitParallelDistances(int start, int goal = -1) {
+        std::vector<int> dist(gridSize, -1);
+        std::vector<uint64_t> frontier(rows * rowWords, 0), next(rows * rowWords, 0);
+        std::vector<uint64_t> visited(rows * rowWords, 0);
+        
+        auto [sr, sc] = indexToPos(start);
+        frontier[sr * rowWords + sc / 64] = 1ULL << (sc % 64);
+        visited = frontier;
+        dist[start] = 0;
+        int rLo = sr, rHi = sr;     // Rows that hold frontier bits
+        
+        for (int layer = 1; goal == -1 || dist[goal] == -1; layer++) {
+            int eLo = std::max(0, rLo - 1), eHi = std::min(rows - 1, rHi + 1);
+            expandRows(frontier, visited, next, eLo, eHi);
+            
+            // Record layer for new cells and find the new frontier row range
+            int newLo = rows, newHi = -1;
+            for (int r = eLo; r <= eHi; r++) {
+                for (int w = 0; w < rowWords; w++) {
+                    uint64_t bits = next[r * rowWords + w];
+                    if (!bits) continue;
+                    newLo = std::min(newLo, r);
+                    newHi = r;
+                    visited[r * rowWords + w] |= bits;
+                    while (bits) {
+                        dist[posToIndex(r, w * 64 + __builtin_ctzll(bits))] = layer;
+                        bits &= bits - 1;
+                    }
+                }
+            }
+            
+            // Clear the old frontier rows, then swap in the new one
+            std::fill(frontier.begin() + rLo * rowWords, frontier.begin() + (rHi + 1) * rowWords, 0);
+            std::swap(frontier, next);
+            if (newHi == -1) break;     // Wavefront died out
+            rLo = newLo;
+            rHi = newHi;
+        }
+        return dist;
+    }
+    
+    // Unit-cost query using the bit-parallel BFS; the path follows decreasing layer index
+    bool solveBitParallel(int start, int goal) {
         startPos = start;
         goalPos = goal;
+        startList = {start};
+        goalList = {goal};
+        if (terrainDirty) updateTerrainBounds();
+        
+        if (minCellCost != maxCellCost) {
+            std::cout << "Bit-parallel BFS needs uniform cell costs; use A* for weighted terrain." << std::endl;
+            return false;
+        }
+        if (!sameComponent(startPos, goalPos)) {
+            std::cout << "No path found to goal! (start and goal are not connected)" << std::endl;
+            return false;
+        }
+        
+        std::vector<int> dist = bitParallelDistances(startPos, goalPos);
+        int explored = 0;
+        for (int d : dist) if (d != -1) explored++;
         
-        // Initialize start state
-        State startState;
-        startState.id = 0;
-        startState.pos = startPos;
-        startState.parent = -1;
-        startState.depth = 0;
-        startState.gCost = 0;
-        startState.hCost = manhattan(startPos, goalPos) * 10;
-        startState.fCost = startState.gCost + startState.hCost;
+        std::vector<int> path = {goalPos};
+        const std::pair<int, int> neighbours[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        while (path.back() != startPos) {
+            auto [row, col] = indexToPos(path.back());
+            for (const auto& [dr, dc] : neighbours) {
+                if (isValid(row + dr, col + dc) && dist[posToIndex(row + dr, col + dc)] == dist[path.back()] - 1) {
+                    path.push_back(posToIndex(row + dr, col + dc));
+                    break;
+                }
+            }
+        }
+        std::reverse(path.begin(), path.end());
         
-        openList.push(startState);
-        openSet.insert(startState.pos);
-        allStates[startState.id] = startState;
+        std::cout << "\nGoal reached!\n";
+        std::cout << "Cells labelled: " << explored << std::endl;
+        std::cout << "Path length: " << dist[goalPos] << std::endl;
+        std::cout << "Path cost: " << dist[goalPos] * 10 * minCellCost << std::endl;
+        printMazeWithPath(path);
+        
+        std::cout << "\nPath coordinates: ";
+        for (int pos : path) {
+            auto [row, col] = indexToPos(pos);
+            std::cout << "(" << row << "," << col << ") ";
+        }
+        std::cout << std::endl;
+        return true;
+    }
+    
+    // Reverse Dijkstra from `goal`: dist[u] = cheapest cost of walking from u to goal
+    // (entering cell v costs 10 * cellCost(v)); -1 for cells that cannot reach goal.
+    // Uniform-cost mazes use the bit-parallel BFS instead.
+    std::vector<int> buildDistanceField(int goal) {
+        if (terrainDirty) updateTerrainBounds();
+        
+        if (minCellCost == maxCellCost) {
+            std::vector<int> dist = bitParallelDistances(goal);
+            for (int& d : dist) if (d != -1) d *= 10 * minCellCost;
+            return dist;
+        }
+        
+        std::vector<int> dist(gridSize, -1);
+        BucketQueue queue;
+        queue.reset(10 * maxCellCost + 1);
+        
+        State root;
+        root.pos = goal;
+        queue.push(root);
+        dist[goal] = 0;
+        
+        const std::pair<int, int> neighbours[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        while (!queue.empty()) {
+            State current = queue.pop();
+            if (current.fCost != dist[current.pos]) continue;   // Stale entry
+            
+            auto [row, col] = indexToPos(current.pos);
+            int stepCost = 10 * cellCost(row, col);             // Cost of stepping into `current`
+            for (const auto& [dr, dc] : neighbours) {
+                if (!isValid(row + dr, col + dc)) continue;
+                int next = posToIndex(row + dr, col + dc);
+                if (dist[next] == -1 || current.fCost + stepCost < dist[next]) {
+                    dist[next] = current.fCost + stepCost;
+                    State s;
+                    s.pos = next;
+                    s.fCost = dist[next];
+                    queue.push(s);
+                }
+            }
+        }
+        return dist;
+    }
+    
+    // Returns the distance field rooted at `goal`, building it on a cache miss
+    const std::vector<int>& distanceField(int goal) {
+        auto it = fieldCache.find(goal);
+        if (it != fieldCache.end()) {
+            fieldLru.splice(fieldLru.begin(), fieldLru, it->second.second);
+            return it->second.first;
+        }
+        
+        if (fieldCache.size() >= fieldCacheCapacity && !fieldLru.empty()) {
+            fieldCache.erase(fieldLru.back());
+            fieldLru.pop_back();
+        }
+        fieldLru.push_front(goal);
+        auto& entry = fieldCache[goal];
+        entry.first = buildDistanceField(goal);
+        entry.second = fieldLru.begin();
+        return entry.first;
+    }
+    
+    // Follows decreasing distance from `start` to `goal` in O(path length);
+    // returns an empty path if goal is unreachable
+    std::vector<int> pathFromField(int start, int goal) {
+        std::vector<int> path;
+        if (!sameComponent(start, goal)) return path;
+        
+        const std::vector<int>& dist = distanceField(goal);
+        const std::pair<int, int> neighbours[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        path.push_back(start);
+        while (path.back() != goal) {
+            auto [row, col] = indexToPos(path.back());
+            for (const auto& [dr, dc] : neighbours) {
+                if (!isValid(row + dr, col + dc)) continue;
+                int next = posToIndex(row + dr, col + dc);
+                if (dist[next] + 10 * cellCost(row + dr, col + dc) == dist[path.back()]) {
+                    path.push_back(next);
+                    break;
+                }
+            }
+        }
+        return path;
+    }
+    
+    // Answers a query from the goal's cached distance field
+    bool solveWithField(int start, int goal) {
+        startPos = start;
+        goalPos = goal;
+        startList = {start};
+        goalList = {goal};
+        
+        std::vector<int> path = pathFromField(start, goal);
+        if (path.empty()) {
+            std::cout << "No path found to goal! (start and goal are not connected)" << std::endl;
+            return false;
+        }
+        
+        std::cout << "\nGoal reached!\n";
+        std::cout << "Path length: " << path.size() - 1 << std::endl;
+        std::cout << "Path cost: " << distanceField(goal)[start] << std::endl;
+        printMazeWithPath(path);
+        
+        std::cout << "\nPath coordinates: ";
+        for (int pos : path) {
+            auto [row, col] = indexToPos(pos);
+            std::cout << "(" << row << "," << col << ") ";
+        }
+        std::cout << std::endl;
+        return true;
+    }
+    
+    bool solve(int start, int goal) {
+        return solveMulti({start}, {goal});
+    }
+    
+    // One search for many starts and/or goals: finds the cheapest path from any
+    // start to its nearest goal (e.g. nearest of many depots, or many agents to one exit)
+    bool solveMulti(const std::vector<int>& starts, const std::vector<int>& goals) {
+        startList = starts;
+        goalList.clear();
+        
+        // Keep only goals that share a region with some start
+        std::unordered_set<int> startRegions;
+        for (int s : starts) startRegions.insert(findComponentOf(s));
+        for (int g : goals) {
+            if (startRegions.count(findComponentOf(g))) goalList.push_back(g);
+        }
+        
+        // Unreachable goal: start and goal are in different regions of the maze
+        if (goalList.empty()) {
+            goalList = goals;
+            std::cout << "No path found to goal! (start and goal are not connected)" << std::endl;
+            std::cout << "Nodes explored: 0" << std::endl;
+            return false;
+        }
+        
+        if (terrainDirty) updateTerrainBounds();
+        
+        // Bucket span covers the largest f-cost increase along one move
+        openList.reset(14 * maxCellCost + 20 * minCellCost + 1);
+        bestG.assign(gridSize, INT_MAX);
+        goalCell.assign(gridSize, 0);
+        for (int g : goalList) goalCell[g] = 1;
+        closed.assign(gridSize, 0);
+        allStates.clear();
+        nodeCounter = 0;
+        
+        // Initialize start states
+        for (int s : starts) {
+            if (bestG[s] == 0) continue;    // Duplicate start
+            State startState;
+            startState.id = nodeCounter++;
+            startState.pos = s;
+            startState.parent = -1;
+            startState.depth = 0;
+            startState.gCost = 0;
+            startState.hCost = heuristic(s);
+            startState.fCost = startState.gCost + startState.hCost;
+            
+            openList.push(startState);
+            bestG[startState.pos] = 0;
+            allStates[startState.id] = startState;
+        }
         
         int nodesExplored = 0;
         
         while (!openList.empty()) {
-            State current = openList.top();
-            openList.pop();
+            State current = openList.pop();
             
-            openSet.erase(current.pos);
-            closedSet.insert(current.pos);
+            // Skip stale entries superseded by a cheaper path (lazy deletion)
+            if (closed[current.pos]) continue;
+            closed[current.pos] = 1;
             nodesExplored++;
             
             // Goal test
-            if (current.pos == goalPos) {
+            if (goalCell[current.pos]) {
                 std::cout << "\nGoal reached!\n";
                 std::cout << "Nodes explored: " << nodesExplored << std::endl;
                 std::cout << "Path length: " << current.depth << std::endl;
                 std::cout << "Path cost: " << current.gCost << std::endl;
                 
                 std::vector<int> path = reconstructPath(current);
+                startPos = path.front();
+                goalPos = path.back();
                 printMazeWithPath(path);
                 
                 std::cout << "\nPath coordinates: ";
@@ -188,10 +710,8 @@ public:
             }
             
             // Progress update
-            if (nodesExplored % 100 == 0) {
-                std::cout << "Nodes explored: " << nodesExplored 
-                         << ", Open list size: " << openList.size()
-                         << ", Current f-cost: " << current.fCost << std::endl;
+            if (progressCallback && nodesExplored % PROGRESS_INTERVAL == 0) {
+                progressCallback({nodesExplored, openList.size(), current.fCost, -1, 1.0, 0.0});
             }
             
             // Generate successors
@@ -199,34 +719,15 @@ public:
             
             for (State& successor : successors) {
                 // Skip if already in closed set
-                if (closedSet.find(successor.pos) != closedSet.end()) {
+                if (closed[successor.pos]) {
                     continue;
                 }
                 
-                // Check if this path to successor is better than any previous one
-                bool inOpenSet = openSet.find(successor.pos) != openSet.end();
-                bool betterPath = false;
-                
-                if (!inOpenSet) {
-                    betterPath = true;
-                } else {
-                    // Find existing state with same position and compare costs
-                    for (auto& [id, state] : allStates) {
-                        if (state.pos == successor.pos && openSet.count(state.pos)) {
-                            if (successor.gCost < state.gCost) {
-                                betterPath = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-                
-                if (betterPath) {
+                // Keep the successor only if it improves the best known path to its cell
+                if (successor.gCost < bestG[successor.pos]) {
+                    bestG[successor.pos] = successor.gCost;
                     allStates[successor.id] = successor;
-                    if (!inOpenSet) {
-                        openList.push(successor);
-                        openSet.insert(successor.pos);
-                    }
+                    openList.push(successor);
                 }
             }
         }
@@ -235,6 +736,135 @@ public:
         std::cout << "Nodes explored: " << nodesExplored << std::endl;
         return false;
     }
+
+    // Anytime Repairing A* (ARA*): runs weighted A* with f = g + epsilon * h to get a
+    // first path quickly, then lowers epsilon and repairs the search, reusing previous
+    // g-costs, until epsilon reaches 1 or the deadline passes. Always returns the best
+    // path found so far together with its proven suboptimality bound.
+    AnytimeResult solveAnytime(int start, int goal, double initialEpsilon,
+                               std::chrono::steady_clock::time_point deadline,
+                               double epsilonStep = 0.5) {
+        using Clock = std::chrono::steady_clock;
+        auto startTime = Clock::now();
+        AnytimeResult result = {{}, -1, initialEpsilon, true};
+        
+        startPos = start;
+        goalPos = goal;
+        startList = {start};
+        goalList = {goal};
+        if (!sameComponent(start, goal)) {
+            result.connected = false;
+            return result;
+        }
+        if (terrainDirty) updateTerrainBounds();
+        
+        struct Entry {
+            double key;
+            int g;
+            int pos;
+            bool operator>(const Entry& other) const { return key > other.key; }
+        };
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        std::vector<int> g(gridSize, INT_MAX), parent(gridSize, -1);
+        std::vector<char> closedCell(gridSize, 0), inOpen(gridSize, 0), inIncons(gridSize, 0);
+        std::vector<int> incons;    // Closed cells whose g improved (re-opened next round)
+        double epsilon = std::max(1.0, initialEpsilon);
+        int nodesExplored = 0;
+        bool timedOut = false;
+        
+        auto push = [&](int pos) {
+            open.push({g[pos] + epsilon * heuristic(pos), g[pos], pos});
+            inOpen[pos] = 1;
+        };
+        
+        // Expands until the goal is the best entry in open (or time runs out)
+        auto improvePath = [&]() {
+            const std::pair<int, int> neighbours[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+            while (!open.empty()) {
+                Entry top = open.top();
+                if (top.g != g[top.pos] || closedCell[top.pos]) { open.pop(); continue; }  // Stale
+                if (g[goal] != INT_MAX && g[goal] <= top.key) return;
+                
+                // Checking the clock every node would dominate small searches
+                if ((nodesExplored & 255) == 0 && Clock::now() >= deadline) { timedOut = true; return; }
+                open.pop();
+                inOpen[top.pos] = 0;
+                closedCell[top.pos] = 1;
+                nodesExplored++;
+                
+                if (progressCallback && nodesExplored % PROGRESS_INTERVAL == 0) {
+                    double ms = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+                    progressCallback({nodesExplored, open.size(), (int)top.key, result.cost, epsilon, ms});
+                }
+                
+                auto [row, col] = indexToPos(top.pos);
+                for (const auto& [dr, dc] : neighbours) {
+                    if (!isValid(row + dr, col + dc)) continue;
+                    int next = posToIndex(row + dr, col + dc);
+                    int newG = g[top.pos] + 10 * cellCost(row + dr, col + dc);
+                    if (newG >= g[next]) continue;
+                    g[next] = newG;
+                    parent[next] = top.pos;
+                    if (!closedCell[next]) push(next);
+                    else if (!inIncons[next]) { inIncons[next] = 1; incons.push_back(next); }
+                }
+            }
+        };
+        
+        // Lowest unweighted f among open/incons states: a lower bound on the optimal cost
+        auto lowerBound = [&]() {
+            int bound = INT_MAX;
+            auto heap = open;
+            while (!heap.empty()) {
+                Entry e = heap.top();
+                heap.pop();
+                if (e.g == g[e.pos] && !closedCell[e.pos]) bound = std::min(bound, e.g + heuristic(e.pos));
+            }
+            for (int pos : incons) bound = std::min(bound, g[pos] + heuristic(pos));
+            return bound;
+        };
+        
+        g[start] = 0;
+        push(start);
+        
+        while (true) {
+            improvePath();
+            if (g[goal] != INT_MAX && (result.cost == -1 || g[goal] < result.cost || !timedOut)) {
+                // Publish the (possibly improved) solution and its proven bound
+                result.path.clear();
+                for (int pos = goal; pos != -1; pos = parent[pos]) result.path.push_back(pos);
+                std::reverse(result.path.begin(), result.path.end());
+                result.cost = g[goal];
+                // A pass cut short by the deadline proves nothing about epsilon, only the g / bound ratio
+                int bound = lowerBound();
+                double proven = bound == INT_MAX ? 1.0 : std::max(1.0, (double)g[goal] / bound);
+                result.epsilon = timedOut ? proven : std::min(epsilon, proven);
+                
+                if (progressCallback) {
+                    double ms = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+                    progressCallback({nodesExplored, open.size(), result.cost, result.cost, result.epsilon, ms});
+                }
+            }
+            if (timedOut || result.epsilon <= 1.0 || (open.empty() && incons.empty())) break;
+            
+            // Tighten epsilon, move incons into open and rebuild keys for the new epsilon
+            epsilon = std::max(1.0, std::min(epsilon, result.epsilon) - epsilonStep);
+            std::vector<int> reopen = incons;
+            while (!open.empty()) {
+                Entry e = open.top();
+                open.pop();
+                if (e.g == g[e.pos] && !closedCell[e.pos] && inOpen[e.pos]) {
+                    reopen.push_back(e.pos);
+                    inOpen[e.pos] = 0;
+                }
+            }
+            for (int pos : incons) inIncons[pos] = 0;
+            incons.clear();
+            std::fill(closedCell.begin(), closedCell.end(), 0);
+            for (int pos : reopen) if (!inOpen[pos]) push(pos);
+        }
+        return result;
+    }
 };
 
 int main() {
@@ -243,7 +873,7 @@ int main() {
     int rows, cols;
     std::cin >> rows >> cols;
     
-    std::cout << "Enter maze (0 = open, -1 = blocked):\n";
+    std::cout << "Enter maze (0 = open, -1 = blocked, >0 = terrain cost):\n";
     std::vector<std::vector<int>> maze(rows, std::vector<int>(cols));
     
     for (int i = 0; i < rows; i++) {
@@ -272,12 +902,79 @@ int main() {
         return 1;
     }
     
-    AStar solver(maze);
-    int startPos = startRow * cols + startCol;
-    int goalPos = goalRow * cols + goalCol;
+    // Wide maps use the tiled layout to keep vertical neighbours close in memory
+    AStar solver(maze, 16, cols >= 1024);
+    int startPos = solver.posToIndex(startRow, startCol);
+    int goalPos = solver.posToIndex(goalRow, goalCol);
+    
+    std::cout << "\nChoose search algorithm:\n";
+    std::cout << "1. A* Search\n";
+    std::cout << "2. Bit-parallel BFS (unit-cost mazes)\n";
+    std::cout << "3. Goal distance field (many starts, same goal)\n";
+    std::cout << "4. A* to nearest of several goals\n";
+    std::cout << "5. Anytime ARA* with a time limit\n";
+    std::cout << "Enter choice (1-5): ";
+    int choice;
+    std::cin >> choice;
     
-    std::cout << "\nStarting A* search...\n";
-    bool solved = solver.solve(startPos, goalPos);
+    solver.setProgressCallback([](const SearchProgress& p) {
+        std::cout << "Nodes explored: " << p.nodesExplored
+                  << ", Open list size: " << p.openSize
+                  << ", Current f-cost: " << p.currentF;
+        if (p.bestCost != -1) std::cout << ", Best cost: " << p.bestCost << ", Bound: " << p.epsilon;
+        std::cout << '\n';
+    });
+    
+    bool solved;
+    if (choice == 2) {
+        std::cout << "\nStarting bit-parallel BFS...\n";
+        solved = solver.solveBitParallel(startPos, goalPos);
+    } else if (choice == 3) {
+        std::cout << "\nBuilding distance field from goal...\n";
+        solved = solver.solveWithField(startPos, goalPos);
+    } else if (choice == 4) {
+        std::vector<int> goals = {goalPos};
+        int extraGoals;
+        std::cout << "Enter number of additional goals: ";
+        std::cin >> extraGoals;
+        for (int k = 0; k < extraGoals; k++) {
+            int r, c;
+            std::cout << "Enter goal position (row col): ";
+            std::cin >> r >> c;
+            if (r < 0 || r >= rows || c < 0 || c >= cols || maze[r][c] == -1) {
+                std::cout << "Skipping invalid or blocked goal." << std::endl;
+                continue;
+            }
+            goals.push_back(solver.posToIndex(r, c));
+        }
+        std::cout << "\nStarting multi-goal A* search...\n";
+        solved = solver.solveMulti({startPos}, goals);
+    } else if (choice == 5) {
+        int budgetMs;
+        double epsilon;
+        std::cout << "Enter time limit in ms: ";
+        std::cin >> budgetMs;
+        std::cout << "Enter initial suboptimality bound (e.g. 3.0): ";
+        std::cin >> epsilon;
+        
+        std::cout << "\nStarting anytime ARA* search...\n";
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+        AnytimeResult result = solver.solveAnytime(startPos, goalPos, epsilon, deadline);
+        solved = !result.path.empty();
+        if (solved) {
+            std::cout << "\nGoal reached!\n";
+            std::cout << "Path length: " << result.path.size() - 1 << std::endl;
+            std::cout << "Path cost: " << result.cost << " (at most " << result.epsilon << " x optimal)" << std::endl;
+            solver.printMazeWithPath(result.path);
+        } else if (!result.connected) {
+            std::cout << "No path found to goal! (start and goal are not connected)" << std::endl;
+        } else {
+            std::cout << "No path found within the time limit." << std::endl;
+        }
+    } else {
+        std::cout << "\nStarting A* search...\n";
+        solved = solver.solve(startPos, goalPos);
+    }
     
     if (!solved) {
         std::cout << "Failed to find a path from start to goal." << std::endl;
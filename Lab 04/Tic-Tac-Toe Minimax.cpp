@@ -2,33 +2,226 @@
 #include <vector>
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <chrono>
+#include <sstream>
+#include <string>
 
 class MinimaxTicTacToe {
 private:
-    char board[3][3];
+    // Bitboard: one 9-bit mask per player, bit (3 * row + col) set if the cell is taken
+    uint16_t xBits = 0;
+    uint16_t oBits = 0;
     char AI_PLAYER = 'X';
     char HUMAN_PLAYER = 'O';
+    bool verbose = true;
+    bool detailedStats = false;     // Nodes per ply, principal variation and timing (see SearchStats)
     char EMPTY = ' ';
 
+    static constexpr uint16_t FULL_BOARD = 0x1FF;
+    static constexpr uint16_t WIN_LINES[8] = {
+        0x007, 0x038, 0x1C0,    // Rows
+        0x049, 0x092, 0x124,    // Columns
+        0x111, 0x054            // Diagonals
+    };
+
+    uint16_t& bitsOf(char player) {
+        return player == 'X' ? xBits : oBits;
+    }
+
+    uint16_t emptyCells() const {
+        return FULL_BOARD & ~(xBits | oBits);
+    }
+
+    char cellAt(int row, int col) const {
+        uint16_t bit = 1 << (3 * row + col);
+        if (xBits & bit) return 'X';
+        if (oBits & bit) return 'O';
+        return EMPTY;
+    }
+
+    static constexpr bool hasLine(uint16_t bits) {
+        for (uint16_t line : WIN_LINES)
+            if ((bits & line) == line) return true;
+        return false;
+    }
+
+    // ---- Perfect-play table, generated at compile time ----
+    // Positions are indexed by their base-3 code (cell digit: 0 = empty, 1 = X, 2 = O).
+    // value is from the side to move's point of view: +/-(10 - plies to the end) for a
+    // win/loss, 0 for a draw, so quicker wins and slower losses score higher, exactly as
+    // in minimax(). move is the lowest cell with the best value (-1 at terminal positions).
+    static constexpr int POSITIONS = 19683;    // 3^9
+
+    struct PerfectPlayTable {
+        int8_t value[POSITIONS];
+        int8_t move[POSITIONS];
+        int16_t base3[512];     // base3[mask] = sum of 3^cell over the set bits
+        uint8_t popcount[512];
+    };
+
+    // Retrograde solve: positions with more pieces are finished before those with fewer,
+    // so every child is already known when its parent is evaluated
+    static constexpr PerfectPlayTable solvePerfectPlay() {
+        PerfectPlayTable t{};
+        for (int m = 0; m < 512; m++) {
+            int power = 1;
+            for (int cell = 0; cell < 9; cell++, power *= 3) {
+                if (m >> cell & 1) {
+                    t.base3[m] += power;
+                    t.popcount[m]++;
+                }
+            }
+        }
+
+        for (int pieces = 9; pieces >= 0; pieces--) {
+            for (int x = 0; x < 512; x++) {
+                int rest = FULL_BOARD & ~x;
+                for (int o = rest; ; o = (o - 1) & rest) {     // Every subset of the free cells
+                    int cx = t.popcount[x], co = t.popcount[o];
+                    if (cx + co == pieces && (cx == co || cx == co + 1)) {
+                        bool xToMove = cx == co;
+                        int mine = xToMove ? x : o, theirs = xToMove ? o : x;
+                        int code = t.base3[x] + 2 * t.base3[o];
+                        t.move[code] = -1;
+
+                        if (hasLine(theirs)) t.value[code] = -10;
+                        else if (hasLine(mine)) t.value[code] = 10;
+                        else if (pieces == 9) t.value[code] = 0;
+                        else {
+                            int best = -128;
+                            for (int cell = 0; cell < 9; cell++) {
+                                if ((x | o) >> cell & 1) continue;
+                                int child = code + (xToMove ? 1 : 2) * t.base3[1 << cell];
+                                int v = -t.value[child];
+                                v = v > 0 ? v - 1 : v < 0 ? v + 1 : 0;   // One ply further away
+                                if (v > best) {
+                                    best = v;
+                                    t.move[code] = cell;
+                                }
+                            }
+                            t.value[code] = best;
+                        }
+                    }
+                    if (o == 0) break;
+                }
+            }
+        }
+        return t;
+    }
+
+    static const PerfectPlayTable& perfectPlay() {
+        static constexpr PerfectPlayTable table = solvePerfectPlay();
+        return table;
+    }
+
+    // Perfect-play line from the current board, read from the table
+    std::vector<int> tableLine() const {
+        const PerfectPlayTable& table = perfectPlay();
+        std::vector<int> line;
+        uint16_t x = xBits, o = oBits;
+        for (int cell; (cell = table.move[table.base3[x] + 2 * table.base3[o]]) != -1;) {
+            line.push_back(cell);
+            (table.popcount[x] == table.popcount[o] ? x : o) |= 1 << cell;
+        }
+        return line;
+    }
+
+public:
+    // Statistics of one getBestMove() or searchBestMove() call. nodes is always counted;
+    // plyNodes, pv and timeMs are only filled with setDetailedStats(true). Plain minimax
+    // has no cutoffs or transposition table, so those counters stay 0.
+    struct SearchStats {
+        static constexpr int MAX_PLY = 10;
+        const char* source = "search";      // "search", or "table" for a perfect-play lookup
+        long long nodes = 0;
+        long long cutoffs = 0;
+        long long firstMoveCutoffs = 0;
+        long long ttHits = 0;
+        long long plyNodes[MAX_PLY] = {};   // Nodes by distance from the root (1 = after the AI move)
+        double timeMs = 0;                  // Whole search; one depth-first pass has no per-ply time
+        std::vector<int> pv;                // Principal variation as cells, starting with the AI move
+
+        double firstMoveCutoffRate() const { return cutoffs ? (double)firstMoveCutoffs / cutoffs : 0.0; }
+
+        // Deepest ply that was reached (0 without detailed statistics)
+        int depth() const {
+            int deepest = 0;
+            for (int ply = 1; ply < MAX_PLY; ply++)
+                if (plyNodes[ply]) deepest = ply;
+            return deepest;
+        }
+
+        // Effective branching factor b: the uniform tree of the same depth with
+        // b + b^2 + ... + b^depth = nodes, solved by bisection
+        double branchingFactor() const {
+            int d = depth();
+            if (d == 0) return 0.0;
+            double low = 0.0, high = (double)nodes;
+            for (int step = 0; step < 64; step++) {
+                double b = (low + high) / 2, total = 0.0, power = 1.0;
+                for (int ply = 0; ply < d && total <= nodes; ply++) total += power *= b;
+                (total > nodes ? high : low) = b;
+            }
+            return low;
+        }
+
+        std::string toJson() const {
+            std::ostringstream out;
+            out << "{\"source\": \"" << source << "\", \"nodes\": " << nodes << ", \"cutoffs\": " << cutoffs
+                << ", \"firstMoveCutoffRate\": " << firstMoveCutoffRate() << ", \"ttHits\": " << ttHits
+                << ", \"depth\": " << depth() << ", \"branchingFactor\": " << branchingFactor()
+                << ", \"timeMs\": " << timeMs << ", \"plyNodes\": [";
+            for (int ply = 1; ply <= depth(); ply++) out << (ply > 1 ? ", " : "") << plyNodes[ply];
+            out << "], \"pv\": [";
+            for (size_t i = 0; i < pv.size(); i++) out << (i ? ", " : "") << "[" << pv[i] / 3 << ", " << pv[i] % 3 << "]";
+            out << "]}";
+            return out.str();
+        }
+    };
+
+private:
+    SearchStats stats;
+    // Triangular principal variation table: pvLine[d] holds the best line found below the
+    // node at minimax depth d, in slots d .. pvLength[d] - 1
+    int pvLine[SearchStats::MAX_PLY][SearchStats::MAX_PLY];
+    int pvLength[SearchStats::MAX_PLY];
+
 public:
     MinimaxTicTacToe() {
         initializeBoard();
     }
 
+    void setPlayers(char ai, char human) {
+        AI_PLAYER = ai;
+        HUMAN_PLAYER = human;
+    }
+
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+
+    // Also collect nodes per ply, the principal variation and the search time
+    void setDetailedStats(bool enabled) {
+        detailedStats = enabled;
+    }
+
+    // Statistics of the last getBestMove() or searchBestMove() call
+    const SearchStats& getStats() const {
+        return stats;
+    }
+
     // Initialize empty board
     void initializeBoard() {
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                board[i][j] = EMPTY;
-            }
-        }
+        xBits = 0;
+        oBits = 0;
     }
 
     // Display the current board
     void displayBoard() {
         std::cout << "\n   0   1   2\n";
         for (int i = 0; i < 3; i++) {
-            std::cout << i << "  " << board[i][0] << " | " << board[i][1] << " | " << board[i][2] << "\n";
+            std::cout << i << "  " << cellAt(i, 0) << " | " << cellAt(i, 1) << " | " << cellAt(i, 2) << "\n";
             if (i < 2) std::cout << "  ---|---|---\n";
         }
         std::cout << "\n";
@@ -36,63 +229,38 @@ public:
 
     // Check if position is valid and empty
     bool isValidMove(int row, int col) {
-        return (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == EMPTY);
+        return (row >= 0 && row < 3 && col >= 0 && col < 3 && (emptyCells() >> (3 * row + col) & 1));
     }
 
     // Make a move on the board
     void makeMove(int row, int col, char player) {
         if (isValidMove(row, col)) {
-            board[row][col] = player;
+            bitsOf(player) |= 1 << (3 * row + col);
         }
     }
 
     // Undo a move
     void undoMove(int row, int col) {
-        board[row][col] = EMPTY;
+        uint16_t bit = 1 << (3 * row + col);
+        xBits &= ~bit;
+        oBits &= ~bit;
     }
 
-    // Check for winner or draw
+    // Check for winner or draw: eight mask tests and a popcount
     char checkGameStatus() {
-        // Check rows
-        for (int i = 0; i < 3; i++) {
-            if (board[i][0] == board[i][1] && board[i][1] == board[i][2] && board[i][0] != EMPTY) {
-                return board[i][0];
-            }
-        }
-
-        // Check columns
-        for (int j = 0; j < 3; j++) {
-            if (board[0][j] == board[1][j] && board[1][j] == board[2][j] && board[0][j] != EMPTY) {
-                return board[0][j];
-            }
-        }
-
-        // Check diagonals
-        if (board[0][0] == board[1][1] && board[1][1] == board[2][2] && board[0][0] != EMPTY) {
-            return board[0][0];
-        }
-        if (board[0][2] == board[1][1] && board[1][1] == board[2][0] && board[0][2] != EMPTY) {
-            return board[0][2];
-        }
-
-        // Check for draw
-        bool boardFull = true;
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == EMPTY) {
-                    boardFull = false;
-                    break;
-                }
-            }
-            if (!boardFull) break;
-        }
-        if (boardFull) return 'D'; // Draw
-
+        if (hasLine(xBits)) return 'X';
+        if (hasLine(oBits)) return 'O';
+        if ((xBits | oBits) == FULL_BOARD) return 'D'; // Draw
         return 'C'; // Continue playing
     }
 
     // Minimax algorithm
     int minimax(int depth, bool isMaximizing) {
+        stats.nodes++;
+        if (detailedStats) {
+            stats.plyNodes[depth + 1]++;
+            pvLength[depth] = depth;
+        }
         char status = checkGameStatus();
         
         // Terminal states
@@ -100,59 +268,68 @@ public:
         if (status == HUMAN_PLAYER) return -10 + depth;     // Human wins (delay losses)
         if (status == 'D') return 0;                        // Draw
         
-        if (isMaximizing) {
-            int maxEval = INT_MIN;
-            
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    if (isValidMove(i, j)) {
-                        makeMove(i, j, AI_PLAYER);
-                        int eval = minimax(depth + 1, false);
-                        undoMove(i, j);
-                        maxEval = std::max(maxEval, eval);
-                    }
-                }
-            }
-            return maxEval;
-        } else {
-            int minEval = INT_MAX;
-            
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    if (isValidMove(i, j)) {
-                        makeMove(i, j, HUMAN_PLAYER);
-                        int eval = minimax(depth + 1, true);
-                        undoMove(i, j);
-                        minEval = std::min(minEval, eval);
-                    }
+        uint16_t& mover = bitsOf(isMaximizing ? AI_PLAYER : HUMAN_PLAYER);
+        int bestEval = isMaximizing ? INT_MIN : INT_MAX;
+        
+        // Iterate over the set bits of the empty mask (lowest cell first)
+        for (uint16_t moves = emptyCells(); moves; moves &= moves - 1) {
+            uint16_t bit = moves & -moves;
+            mover |= bit;
+            int eval = minimax(depth + 1, !isMaximizing);
+            mover &= ~bit;
+            if (isMaximizing ? eval > bestEval : eval < bestEval) {
+                bestEval = eval;
+                if (detailedStats) {
+                    pvLine[depth][depth] = __builtin_ctz(bit);
+                    for (int i = depth + 1; i < pvLength[depth + 1]; i++) pvLine[depth][i] = pvLine[depth + 1][i];
+                    pvLength[depth] = pvLength[depth + 1];
                 }
             }
-            return minEval;
         }
+        return bestEval;
     }
 
-    // Get the best move for AI using minimax
+    // Perfect move by table lookup; falls back to search if the board is not a
+    // position where the AI is the side to move (e.g. set up by hand)
     std::pair<int, int> getBestMove() {
-        std::cout << "AI is thinking...\n";
-        
+        if (verbose) std::cout << "AI is thinking...\n";
+        const PerfectPlayTable& table = perfectPlay();
+        bool aiToMove = (table.popcount[xBits] == table.popcount[oBits]) == (AI_PLAYER == 'X');
+        int cell = table.move[table.base3[xBits] + 2 * table.base3[oBits]];
+        if (!aiToMove || cell == -1) return searchBestMove();
+
+        stats = SearchStats();
+        stats.source = "table";
+        if (detailedStats) stats.pv = tableLine();
+        return {cell / 3, cell % 3};
+    }
+
+    // Best move by full search over every AI move
+    std::pair<int, int> searchBestMove() {
+        stats = SearchStats();
+        auto start = std::chrono::steady_clock::now();
         int bestVal = INT_MIN;
         std::pair<int, int> bestMove = {-1, -1};
+        uint16_t& aiBits = bitsOf(AI_PLAYER);
         
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (isValidMove(i, j)) {
-                    makeMove(i, j, AI_PLAYER);
-                    int moveVal = minimax(0, false);
-                    undoMove(i, j);
-                    
-                    if (moveVal > bestVal) {
-                        bestMove = {i, j};
-                        bestVal = moveVal;
-                    }
+        for (uint16_t moves = emptyCells(); moves; moves &= moves - 1) {
+            int cell = __builtin_ctz(moves);
+            aiBits |= 1 << cell;
+            int moveVal = minimax(0, false);
+            aiBits &= ~(1 << cell);
+            
+            if (moveVal > bestVal) {
+                bestMove = {cell / 3, cell % 3};
+                bestVal = moveVal;
+                if (detailedStats) {
+                    stats.pv.assign(1, cell);
+                    stats.pv.insert(stats.pv.end(), pvLine[0], pvLine[0] + pvLength[0]);
                 }
             }
         }
-        
+
+        if (detailedStats)
+            stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
         return bestMove;
     }
 
@@ -219,6 +396,7 @@ public:
                 auto aiMove = getBestMove();
                 makeMove(aiMove.first, aiMove.second, AI_PLAYER);
                 std::cout << "AI chooses position (" << aiMove.first << ", " << aiMove.second << ")\n";
+                if (detailedStats) std::cout << stats.toJson() << "\n";
                 displayBoard();
             }
 
@@ -227,9 +405,16 @@ public:
     }
 };
 
+// main() is left out when the file is included by the tournament harness
+#ifndef ENGINE_NO_MAIN
 int main() {
     MinimaxTicTacToe game;
-    
+
+    char showStats;
+    std::cout << "Print search statistics as JSON after each AI move? (y/n): ";
+    std::cin >> showStats;
+    game.setDetailedStats(showStats == 'y' || showStats == 'Y');
+
     char playAgain;
     do {
         game.initializeBoard();
@@ -243,4 +428,5 @@ int main() {
     
     std::cout << "Thanks for playing!\n";
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,844 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <bitset>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Generalised m,n,k game (k in a row on an m x n board, e.g. 15x15 five-in-a-row)
+// played by an iterative-deepening alpha-beta engine under a per-move time budget
+template <int ROWS, int COLS, int K>
+class MNKAlphaBeta {
+private:
+    static constexpr int CELLS = ROWS * COLS;
+    static constexpr int WIN_SCORE = 1000000;
+
+    using Bits = std::bitset<CELLS>;
+    using Clock = std::chrono::steady_clock;
+
+    Bits stones[2];             // stones[0] = X, stones[1] = O
+    int moveCount = 0;
+    char AI_PLAYER = 'X';
+    char HUMAN_PLAYER = 'O';
+    char EMPTY = '.';
+    bool verbose = true;
+    bool detailedStats = false;     // Nodes per ply, per-iteration timing and principal variation
+
+    // Every run of K cells in a row, column or diagonal ("window"); a window with
+    // stones of only one player is an open line for that player
+    std::vector<std::array<int, K>> windows;
+    int lineWeight[K + 1];      // Score of an open line holding c stones
+
+    // Iterative deepening state
+    Clock::time_point deadline;
+    bool timeUp = false;
+    const std::atomic<bool>* stopFlag = nullptr;   // Set by the main thread to stop Lazy SMP helpers
+
+public:
+    // How getBestMove() uses more than one thread
+    enum class ParallelMode {
+        LAZY_SMP,       // Helpers run their own iterative deepening and share the transposition table
+        ROOT_SPLIT      // Root moves after the first are handed out to threads with a shared alpha
+    };
+
+    // Move ordering stages, each of which can be switched off with setMoveOrdering()
+    struct MoveOrdering {
+        bool ttMoveFirst = true;    // Best move stored in the transposition table
+        bool killers = true;        // Two quiet moves per ply that recently caused cutoffs
+        bool history = true;        // Cells that caused cutoffs anywhere, weighted by depth^2
+        bool pvs = true;            // Principal variation search (null windows after the first move)
+    };
+
+    // Statistics of one getBestMove() call, summed over all search threads. The counters are
+    // always kept; plyNodes, the per-iteration figures and pv are only filled with
+    // setDetailedStats(true), so a normal search pays one predictable branch per node.
+    struct SearchStats {
+        const char* source = "search";      // "search", or "tablebase" for an exact lookup
+        long long nodes = 0;
+        long long cutoffs = 0;
+        long long firstMoveCutoffs = 0;     // Cutoffs caused by the first move tried
+        long long researches = 0;           // PVS null-window searches that had to be repeated
+        long long ttHits = 0;
+        int depth = 0;                      // Deepest completed iteration
+        double timeMs = 0;
+        std::vector<long long> plyNodes;    // Nodes by distance from the root (index 0 unused)
+        std::vector<long long> iterationNodes;  // Nodes and time of each completed iteration
+        std::vector<double> iterationMs;        // (depth 1, 2, ... of the main thread)
+        std::vector<int> pv;                // Principal variation as cells, starting with the AI move
+
+        double firstMoveCutoffRate() const { return cutoffs ? (double)firstMoveCutoffs / cutoffs : 0.0; }
+
+        // Effective branching factor b of the last completed iteration: the uniform tree
+        // of the same depth with b + b^2 + ... + b^depth = its nodes, solved by bisection
+        double branchingFactor() const {
+            if (depth == 0 || iterationNodes.empty()) return 0.0;
+            double target = (double)iterationNodes.back(), low = 0.0, high = target;
+            for (int step = 0; step < 64; step++) {
+                double b = (low + high) / 2, total = 0.0, power = 1.0;
+                for (int ply = 0; ply < depth && total <= target; ply++) total += power *= b;
+                (total > target ? high : low) = b;
+            }
+            return low;
+        }
+
+        std::string toJson() const {
+            std::ostringstream out;
+            auto list = [&out](const auto& values) {
+                out << "[";
+                for (size_t i = 0; i < values.size(); i++) out << (i ? ", " : "") << values[i];
+                out << "]";
+            };
+            out << "{\"source\": \"" << source << "\", \"nodes\": " << nodes << ", \"cutoffs\": " << cutoffs
+                << ", \"firstMoveCutoffRate\": " << firstMoveCutoffRate() << ", \"researches\": " << researches
+                << ", \"ttHits\": " << ttHits << ", \"depth\": " << depth
+                << ", \"branchingFactor\": " << branchingFactor() << ", \"timeMs\": " << timeMs << ", \"plyNodes\": ";
+            size_t plies = plyNodes.size();
+            while (plies > 1 && plyNodes[plies - 1] == 0) plies--;
+            list(std::vector<long long>(plyNodes.begin() + (plies ? 1 : 0), plyNodes.begin() + plies));
+            out << ", \"iterationNodes\": ";
+            list(iterationNodes);
+            out << ", \"iterationMs\": ";
+            list(iterationMs);
+            out << ", \"pv\": [";
+            for (size_t i = 0; i < pv.size(); i++) out << (i ? ", " : "") << "[" << pv[i] / COLS << ", " << pv[i] % COLS << "]";
+            out << "]}";
+            return out.str();
+        }
+    };
+
+private:
+    MoveOrdering ordering;
+    SearchStats stats;
+    std::vector<std::array<int, 2>> killerMoves = std::vector<std::array<int, 2>>(CELLS + 1);
+    std::vector<int> historyScore[2] = {std::vector<int>(CELLS), std::vector<int>(CELLS)};
+
+    int threadCount = 1;
+    ParallelMode parallelMode = ParallelMode::LAZY_SMP;
+
+    // Transposition table (Zobrist hashing, always-replace), shared by all search threads
+    enum Bound : uint8_t { EXACT, LOWER, UPPER };
+
+    struct TTEntry {
+        int value;
+        int bestMove;
+        int depth;
+        Bound bound;
+    };
+
+    // Lock-free slot: the entry is packed into one word and stored next to key ^ data.
+    // A slot torn by two threads writing at once fails the key check instead of
+    // returning another position's data.
+    struct TTSlot {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    static constexpr int TT_SIZE = 1 << 18;
+    std::shared_ptr<std::vector<TTSlot>> table = std::make_shared<std::vector<TTSlot>>(TT_SIZE);
+    uint64_t zobrist[2][CELLS];
+    uint64_t hash = 0;
+
+    // Tablebase written by "MNK Tablebase.cpp": one byte per base-3 rank of the board
+    // (bits 0-1 result for the side to move, bits 2-7 moves to the end). Boards of up to
+    // 16 cells only; the file is memory-mapped and shared by every copy of the engine.
+    enum TablebaseResult : uint8_t { TB_ILLEGAL, TB_WIN, TB_LOSS, TB_DRAW };
+    static constexpr bool TABLEBASE_SIZED = CELLS <= 16;
+    static constexpr size_t TABLEBASE_HEADER = 16;
+    std::shared_ptr<const uint8_t> tablebase;
+    uint64_t pow3[CELLS + 1];
+    uint64_t rank = 0;          // Base-3 rank of the board, digit 1 = X, 2 = O
+
+    // Exact score of the position from the tablebase, in the same units as search()
+    int tablebaseScore(int ply) const {
+        uint8_t entry = tablebase.get()[rank];
+        int moves = entry >> 2;
+        if ((entry & 3) == TB_WIN) return WIN_SCORE - ply - moves + 1;
+        if ((entry & 3) == TB_LOSS) return -(WIN_SCORE - ply - moves + 1);
+        return 0;
+    }
+
+    bool probe(TTEntry& entry) const {
+        const TTSlot& slot = (*table)[hash & (TT_SIZE - 1)];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data == 0 || (slot.check.load(std::memory_order_relaxed) ^ data) != hash) return false;
+        entry.value = (int32_t)(uint32_t)data;
+        entry.bestMove = (int16_t)(uint16_t)(data >> 32);
+        entry.depth = (uint8_t)(data >> 48);
+        entry.bound = (Bound)(data >> 56);
+        return true;
+    }
+
+    void store(int value, int bestMove, int depth, Bound bound) {
+        // depth >= 1 for every stored entry, so data is never 0 (0 marks an empty slot)
+        uint64_t data = (uint64_t)(uint32_t)value | (uint64_t)(uint16_t)bestMove << 32 |
+                        (uint64_t)(uint8_t)depth << 48 | (uint64_t)bound << 56;
+        TTSlot& slot = (*table)[hash & (TT_SIZE - 1)];
+        slot.check.store(hash ^ data, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+    }
+
+    void initZobrist() {
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;     // splitmix64, fixed seed
+        for (auto& side : zobrist) {
+            for (uint64_t& key : side) {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                key = z ^ (z >> 31);
+            }
+        }
+    }
+
+    void place(int cell, int side) {
+        stones[side][cell] = true;
+        hash ^= zobrist[side][cell];
+        if (TABLEBASE_SIZED) rank += (side + 1) * pow3[cell];
+        moveCount++;
+    }
+
+    void remove(int cell, int side) {
+        stones[side][cell] = false;
+        hash ^= zobrist[side][cell];
+        if (TABLEBASE_SIZED) rank -= (side + 1) * pow3[cell];
+        moveCount--;
+    }
+
+    // Win scores depend on the ply they were found at; store them relative to the node
+    static bool isWinScore(int value) { return value > WIN_SCORE - CELLS - 1 || value < -WIN_SCORE + CELLS + 1; }
+    static int toTT(int value, int ply) { return !isWinScore(value) ? value : value > 0 ? value + ply : value - ply; }
+    static int fromTT(int value, int ply) { return !isWinScore(value) ? value : value > 0 ? value - ply : value + ply; }
+
+    // Sorts moves by: table move, killers of this ply, then history score
+    void orderMoves(std::vector<int>& moves, int ply, int side, int ttMove) const {
+        std::vector<std::pair<int, int>> scored;
+        scored.reserve(moves.size());
+        for (int cell : moves) {
+            int score = 0;
+            if (ordering.ttMoveFirst && cell == ttMove) score = 1 << 30;
+            else if (ordering.killers && cell == killerMoves[ply][0]) score = 1 << 29;
+            else if (ordering.killers && cell == killerMoves[ply][1]) score = 1 << 28;
+            else if (ordering.history) score = historyScore[side][cell];
+            scored.push_back({score, cell});
+        }
+        std::stable_sort(scored.begin(), scored.end(),
+                         [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+        for (size_t i = 0; i < moves.size(); i++) moves[i] = scored[i].second;
+    }
+
+    void recordCutoff(int ply, int side, int depth, int cell, int moveIndex) {
+        stats.cutoffs++;
+        if (moveIndex == 0) stats.firstMoveCutoffs++;
+        if (killerMoves[ply][0] != cell) {
+            killerMoves[ply][1] = killerMoves[ply][0];
+            killerMoves[ply][0] = cell;
+        }
+        historyScore[side][cell] += depth * depth;
+    }
+
+    static int sideOf(char player) { return player == 'X' ? 0 : 1; }
+
+    void buildWindows() {
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                for (const auto& d : directions) {
+                    int endR = r + d[0] * (K - 1), endC = c + d[1] * (K - 1);
+                    if (endR < 0 || endR >= ROWS || endC < 0 || endC >= COLS) continue;
+                    std::array<int, K> window;
+                    for (int i = 0; i < K; i++) window[i] = (r + d[0] * i) * COLS + (c + d[1] * i);
+                    windows.push_back(window);
+                }
+            }
+        }
+        lineWeight[0] = 0;
+        for (int c = 1; c <= K; c++) lineWeight[c] = c == 1 ? 1 : lineWeight[c - 1] * 10;
+    }
+
+    // True if the stone just placed at `cell` completes K in a row for `side`
+    bool winsAt(int cell, int side) const {
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int r = cell / COLS, c = cell % COLS;
+        for (const auto& d : directions) {
+            int run = 1;
+            for (int sign = -1; sign <= 1; sign += 2) {
+                int nr = r + sign * d[0], nc = c + sign * d[1];
+                while (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && stones[side][nr * COLS + nc]) {
+                    run++;
+                    nr += sign * d[0];
+                    nc += sign * d[1];
+                }
+            }
+            if (run >= K) return true;
+        }
+        return false;
+    }
+
+    // Heuristic value for `side`: weighted open lines of side minus those of the opponent
+    int evaluate(int side) const {
+        int score = 0;
+        for (const auto& window : windows) {
+            int count[2] = {0, 0};
+            for (int cell : window) {
+                if (stones[0][cell]) count[0]++;
+                else if (stones[1][cell]) count[1]++;
+            }
+            if (count[0] && !count[1]) score += lineWeight[count[0]];
+            else if (count[1] && !count[0]) score -= lineWeight[count[1]];
+        }
+        return side == 0 ? score : -score;
+    }
+
+    // Empty cells within distance 2 of an existing stone (the centre on an empty board)
+    std::vector<int> candidateMoves() const {
+        std::vector<int> moves;
+        if (moveCount == 0) {
+            moves.push_back((ROWS / 2) * COLS + COLS / 2);
+            return moves;
+        }
+        Bits occupied = stones[0] | stones[1];
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (occupied[cell]) continue;
+            int r = cell / COLS, c = cell % COLS;
+            bool near = false;
+            for (int dr = -2; dr <= 2 && !near; dr++) {
+                for (int dc = -2; dc <= 2 && !near; dc++) {
+                    int nr = r + dr, nc = c + dc;
+                    if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && occupied[nr * COLS + nc]) near = true;
+                }
+            }
+            if (near) moves.push_back(cell);
+        }
+        return moves;
+    }
+
+    // Negamax alpha-beta with a transposition table and principal variation search;
+    // scores are from the point of view of `side` (to move)
+    int search(int depth, int ply, int side, int alpha, int beta) {
+        if ((++stats.nodes & 1023) == 0 &&
+            (Clock::now() >= deadline || (stopFlag && stopFlag->load(std::memory_order_relaxed))))
+            timeUp = true;
+        if (detailedStats) stats.plyNodes[ply]++;
+        if (timeUp) return 0;
+        if (moveCount == CELLS) return 0;                       // Draw
+        if (tablebase) return tablebaseScore(ply);
+        if (depth == 0) return evaluate(side);
+
+        TTEntry entry;
+        int ttMove = -1;
+        if (probe(entry)) {
+            stats.ttHits++;
+            ttMove = entry.bestMove;
+            if (entry.depth >= depth) {
+                int value = fromTT(entry.value, ply);
+                if (entry.bound == EXACT) return value;
+                if (entry.bound == LOWER) alpha = std::max(alpha, value);
+                if (entry.bound == UPPER) beta = std::min(beta, value);
+                if (alpha >= beta) return value;
+            }
+        }
+        int alphaOrig = alpha;
+
+        std::vector<int> moves = candidateMoves();
+        orderMoves(moves, ply, side, ttMove);
+
+        int bestVal = -WIN_SCORE - 1;
+        int bestMove = -1;
+        for (size_t i = 0; i < moves.size(); i++) {
+            int cell = moves[i];
+            place(cell, side);
+            int eval;
+            if (winsAt(cell, side)) {
+                eval = WIN_SCORE - ply;                         // Prefer quicker wins
+            } else if (i == 0 || !ordering.pvs) {
+                eval = -search(depth - 1, ply + 1, 1 - side, -beta, -alpha);
+            } else {
+                // PVS: a null window proves the move is no better than alpha
+                eval = -search(depth - 1, ply + 1, 1 - side, -alpha - 1, -alpha);
+                if (eval > alpha && eval < beta) {
+                    stats.researches++;
+                    eval = -search(depth - 1, ply + 1, 1 - side, -beta, -alpha);
+                }
+            }
+            remove(cell, side);
+            if (timeUp) return 0;
+
+            if (eval > bestVal) {
+                bestVal = eval;
+                bestMove = cell;
+            }
+            alpha = std::max(alpha, eval);
+            if (alpha >= beta) {                                // Prune
+                recordCutoff(ply, side, depth, cell, i);
+                break;
+            }
+        }
+
+        store(toTT(bestVal, ply), bestMove, depth, bestVal <= alphaOrig ? UPPER : bestVal >= beta ? LOWER : EXACT);
+        return bestVal;
+    }
+
+    // Scores one root move: immediate wins are not searched further; moves after the
+    // first are tried with a null window when PVS is on
+    int searchRootMove(int cell, int depth, int side, int alpha, int beta, bool firstMove) {
+        place(cell, side);
+        int eval;
+        if (winsAt(cell, side)) {
+            eval = WIN_SCORE;
+        } else if (firstMove || !ordering.pvs) {
+            eval = -search(depth - 1, 1, 1 - side, -beta, -alpha);
+        } else {
+            eval = -search(depth - 1, 1, 1 - side, -alpha - 1, -alpha);
+            if (eval > alpha) {
+                stats.researches++;
+                eval = -search(depth - 1, 1, 1 - side, -beta, -alpha);
+            }
+        }
+        remove(cell, side);
+        return eval;
+    }
+
+    // One root iteration on this thread; returns the best value and sets bestMove
+    int searchRoot(int depth, int side, const std::vector<int>& rootMoves, int& bestMove) {
+        int alpha = -WIN_SCORE - 1, beta = WIN_SCORE + 1;
+        int bestVal = -WIN_SCORE - 1;
+        for (size_t i = 0; i < rootMoves.size(); i++) {
+            int eval = searchRootMove(rootMoves[i], depth, side, alpha, beta, i == 0);
+            if (timeUp) break;
+            if (eval > bestVal) {
+                bestVal = eval;
+                bestMove = rootMoves[i];
+            }
+            alpha = std::max(alpha, eval);
+        }
+        return bestVal;
+    }
+
+    // Root splitting: the first (expected best) move is searched here to get an alpha bound,
+    // then every thread takes the next unsearched root move and tests it against the shared alpha
+    int searchRootSplit(int depth, int side, const std::vector<int>& rootMoves, int& bestMove) {
+        int beta = WIN_SCORE + 1;
+        int bestVal = searchRootMove(rootMoves[0], depth, side, -WIN_SCORE - 1, beta, true);
+        if (timeUp) return 0;
+        bestMove = rootMoves[0];
+
+        std::atomic<int> sharedAlpha(bestVal);
+        std::atomic<size_t> nextMove(1);
+        std::mutex bestLock;
+
+        auto worker = [&](MNKAlphaBeta& engine) {
+            size_t i;
+            while ((i = nextMove.fetch_add(1)) < rootMoves.size()) {
+                int alpha = sharedAlpha.load();
+                int eval = engine.searchRootMove(rootMoves[i], depth, side, alpha, beta, false);
+                if (engine.timeUp) return;
+
+                std::lock_guard<std::mutex> guard(bestLock);
+                if (eval > bestVal) {
+                    bestVal = eval;
+                    bestMove = rootMoves[i];
+                    sharedAlpha.store(eval);
+                }
+            }
+        };
+
+        std::vector<MNKAlphaBeta> helpers(threadCount - 1, *this);
+        std::vector<std::thread> threads;
+        for (auto& helper : helpers) {
+            helper.resetStats();
+            threads.emplace_back(worker, std::ref(helper));
+        }
+        worker(*this);
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& helper : helpers) {
+            timeUp = timeUp || helper.timeUp;
+            mergeStats(helper.stats);
+        }
+        return bestVal;
+    }
+
+    void resetStats() {
+        stats = SearchStats();
+        if (detailedStats) stats.plyNodes.assign(CELLS + 1, 0);
+    }
+
+    void mergeStats(const SearchStats& other) {
+        stats.nodes += other.nodes;
+        stats.cutoffs += other.cutoffs;
+        stats.firstMoveCutoffs += other.firstMoveCutoffs;
+        stats.researches += other.researches;
+        stats.ttHits += other.ttHits;
+        for (size_t ply = 0; ply < other.plyNodes.size() && ply < stats.plyNodes.size(); ply++)
+            stats.plyNodes[ply] += other.plyNodes[ply];
+    }
+
+    // Principal variation after `side` plays `first`: follows the best moves stored in the
+    // transposition table for at most `length` moves, or until the game ends
+    std::vector<int> ttLine(int first, int side, int length) {
+        std::vector<int> line = {first};
+        place(first, side);
+        while ((int)line.size() < length && moveCount < CELLS && !winsAt(line.back(), side)) {
+            side = 1 - side;
+            TTEntry entry;
+            if (!probe(entry) || entry.bestMove < 0 || stones[0][entry.bestMove] || stones[1][entry.bestMove]) {
+                side = 1 - side;
+                break;
+            }
+            line.push_back(entry.bestMove);
+            place(entry.bestMove, side);
+        }
+        for (size_t i = line.size(); i-- > 0; side = 1 - side) remove(line[i], side);
+        return line;
+    }
+
+    // Deepens from `firstDepth` until time runs out or the result is forced;
+    // returns the best move of the deepest completed iteration
+    int iterativeDeepening(int side, std::vector<int> rootMoves, int firstDepth) {
+        int bestMove = rootMoves[0];
+        bool splitRoot = threadCount > 1 && parallelMode == ParallelMode::ROOT_SPLIT;
+
+        for (int depth = firstDepth; depth <= CELLS - moveCount; depth++) {
+            Clock::time_point iterationStart = detailedStats ? Clock::now() : Clock::time_point();
+            long long iterationStartNodes = stats.nodes;
+            int iterationBest = rootMoves[0];
+            int iterationVal = splitRoot ? searchRootSplit(depth, side, rootMoves, iterationBest)
+                                         : searchRoot(depth, side, rootMoves, iterationBest);
+            if (timeUp) break;
+
+            bestMove = iterationBest;
+            stats.depth = depth;
+            if (detailedStats) {
+                stats.iterationNodes.push_back(stats.nodes - iterationStartNodes);
+                stats.iterationMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - iterationStart).count());
+            }
+            std::rotate(rootMoves.begin(), std::find(rootMoves.begin(), rootMoves.end(), bestMove),
+                        std::find(rootMoves.begin(), rootMoves.end(), bestMove) + 1);
+            if (isWinScore(iterationVal)) break;               // Result is forced
+        }
+        return bestMove;
+    }
+
+public:
+    MNKAlphaBeta() {
+        pow3[0] = 1;
+        for (int i = 1; i <= CELLS; i++) pow3[i] = pow3[i - 1] * 3;
+        buildWindows();
+        initZobrist();
+        initializeBoard();
+    }
+
+    void initializeBoard() {
+        stones[0].reset();
+        stones[1].reset();
+        moveCount = 0;
+        hash = 0;
+        rank = 0;
+    }
+
+    static std::string tablebaseFileName() {
+        return "mnk_" + std::to_string(ROWS) + "x" + std::to_string(COLS) + "x" + std::to_string(K) + ".tb";
+    }
+
+    // Maps a tablebase file for this board; returns false if it is missing or does not match
+    bool loadTablebase(const std::string& path) {
+        if (!TABLEBASE_SIZED) return false;
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        off_t size = lseek(fd, 0, SEEK_END);
+        if ((uint64_t)size != TABLEBASE_HEADER + pow3[CELLS]) {    // Also rejects lseek() failing with -1
+            close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return false;
+        std::shared_ptr<const uint8_t> file((const uint8_t*)data, [size](const uint8_t* p) { munmap((void*)p, size); });
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        std::streamoff size = in.tellg();
+        if (size < 0 || (uint64_t)size != TABLEBASE_HEADER + pow3[CELLS]) return false;
+        std::shared_ptr<uint8_t> buffer(new uint8_t[size], std::default_delete<uint8_t[]>());
+        in.seekg(0);
+        if (!in.read((char*)buffer.get(), size)) return false;
+        std::shared_ptr<const uint8_t> file = buffer;
+#endif
+        const uint8_t* header = file.get();
+        uint64_t entries = 0;
+        for (int i = 0; i < 8; i++) entries |= (uint64_t)header[8 + i] << (8 * i);
+        if (std::string((const char*)header, 4) != "MNKT" || header[4] != ROWS || header[5] != COLS || header[6] != K ||
+            header[7] != 1 || entries != pow3[CELLS])
+            return false;
+        tablebase = std::shared_ptr<const uint8_t>(file, header + TABLEBASE_HEADER);   // Shares ownership of the mapping
+        return true;
+    }
+
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+
+    void setMoveOrdering(const MoveOrdering& newOrdering) {
+        ordering = newOrdering;
+    }
+
+    // Also collect nodes per ply, per-iteration nodes and time, and the principal variation
+    void setDetailedStats(bool enabled) {
+        detailedStats = enabled;
+    }
+
+    // Number of search threads (1 = serial) and how they split the work
+    void setParallelSearch(int threads, ParallelMode mode) {
+        threadCount = std::max(1, threads);
+        parallelMode = mode;
+    }
+
+    // Statistics of the last getBestMove() call
+    const SearchStats& getStats() const {
+        return stats;
+    }
+
+    void setPlayers(char ai, char human) {
+        AI_PLAYER = ai;
+        HUMAN_PLAYER = human;
+    }
+
+    void displayBoard() const {
+        std::cout << "\n   ";
+        for (int c = 0; c < COLS; c++) std::cout << (c < 10 ? " " : "") << c << " ";
+        std::cout << "\n";
+        for (int r = 0; r < ROWS; r++) {
+            std::cout << (r < 10 ? " " : "") << r << " ";
+            for (int c = 0; c < COLS; c++) {
+                int cell = r * COLS + c;
+                std::cout << "  " << (stones[0][cell] ? 'X' : stones[1][cell] ? 'O' : EMPTY);
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    bool isValidMove(int row, int col) const {
+        return row >= 0 && row < ROWS && col >= 0 && col < COLS &&
+               !stones[0][row * COLS + col] && !stones[1][row * COLS + col];
+    }
+
+    // Places a stone; returns true if it wins the game
+    bool makeMove(int row, int col, char player) {
+        int cell = row * COLS + col;
+        place(cell, sideOf(player));
+        return winsAt(cell, sideOf(player));
+    }
+
+    bool isFull() const { return moveCount == CELLS; }
+
+    char cellAt(int row, int col) const {
+        int cell = row * COLS + col;
+        return stones[0][cell] ? 'X' : stones[1][cell] ? 'O' : EMPTY;
+    }
+
+    // Iterative deepening: searches depth 1, 2, ... until the time budget runs out and
+    // returns the best move of the deepest completed iteration. The previous iteration's
+    // best move is searched first, which makes the next iteration cheaper.
+    // With Lazy SMP, helper threads deepen the same position in the background (odd helpers
+    // one ply ahead, each with its own root order) and only contribute through the shared table.
+    std::pair<int, int> getBestMove(std::chrono::milliseconds budget) {
+        if (verbose) std::cout << "AI is thinking...\n";
+        Clock::time_point start = Clock::now();
+        deadline = start + budget;
+        timeUp = false;
+        stopFlag = nullptr;
+        resetStats();
+        for (auto& killers : killerMoves) killers = {-1, -1};
+        for (auto& side : historyScore) std::fill(side.begin(), side.end(), 0);
+
+        int side = sideOf(AI_PLAYER);
+        if (tablebase) return tablebaseMove(side);
+        std::vector<int> rootMoves = candidateMoves();
+
+        std::atomic<bool> stopHelpers(false);
+        std::vector<MNKAlphaBeta> helpers;
+        std::vector<std::thread> threads;
+        if (threadCount > 1 && parallelMode == ParallelMode::LAZY_SMP) {
+            helpers.assign(threadCount - 1, *this);
+            for (int id = 1; id < threadCount; id++) {
+                MNKAlphaBeta& helper = helpers[id - 1];
+                helper.stopFlag = &stopHelpers;
+                std::vector<int> helperMoves = rootMoves;
+                std::rotate(helperMoves.begin(), helperMoves.begin() + id % helperMoves.size(), helperMoves.end());
+                threads.emplace_back([&helper, side, helperMoves, id] {
+                    helper.iterativeDeepening(side, helperMoves, 1 + id % 2);
+                });
+            }
+        }
+
+        int bestMove = iterativeDeepening(side, rootMoves, 1);
+
+        stopHelpers = true;
+        for (auto& thread : threads) thread.join();
+        for (const auto& helper : helpers) mergeStats(helper.stats);
+        if (detailedStats) {
+            stats.pv = ttLine(bestMove, side, std::max(stats.depth, 1));
+            stats.timeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        if (verbose)
+            std::cout << "Searched to depth " << stats.depth << " (" << stats.nodes << " nodes, "
+                  << (int)(100 * stats.firstMoveCutoffRate()) << "% first-move cutoffs)\n";
+        return {bestMove / COLS, bestMove % COLS};
+    }
+
+    // Best tablebase move for `side` and its score
+    int tablebaseBest(int side, int& bestVal) {
+        int bestMove = -1;
+        bestVal = -WIN_SCORE - 1;
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (stones[0][cell] || stones[1][cell]) continue;
+            place(cell, side);
+            int eval = winsAt(cell, side) ? WIN_SCORE : moveCount == CELLS ? 0 : -tablebaseScore(1);
+            remove(cell, side);
+            if (eval > bestVal) {
+                bestVal = eval;
+                bestMove = cell;
+            }
+        }
+        return bestMove;
+    }
+
+    // With a tablebase every move is answered exactly: win fastest, else draw, else lose slowest
+    std::pair<int, int> tablebaseMove(int side) {
+        int bestVal;
+        int bestMove = tablebaseBest(side, bestVal);
+        stats.source = "tablebase";
+        if (detailedStats) {
+            // Perfect line for both sides, undone afterwards
+            for (int mover = side, value; moveCount < CELLS; mover = 1 - mover) {
+                int cell = tablebaseBest(mover, value);
+                stats.pv.push_back(cell);
+                place(cell, mover);
+                if (winsAt(cell, mover)) break;
+            }
+            for (size_t i = stats.pv.size(); i-- > 0;) remove(stats.pv[i], (int)(side + i) % 2);
+        }
+        if (verbose) {
+            std::cout << "Tablebase: ";
+            if (bestVal == 0) std::cout << "draw\n";
+            else std::cout << (bestVal > 0 ? "win" : "loss") << " in " << WIN_SCORE - std::abs(bestVal) + 1 << " move(s)\n";
+        }
+        return {bestMove / COLS, bestMove % COLS};
+    }
+
+    std::pair<int, int> getHumanMove() const {
+        int row, col;
+        while (true) {
+            std::cout << "Enter your move (row col): ";
+            std::cin >> row >> col;
+            if (isValidMove(row, col)) return {row, col};
+            std::cout << "Invalid move! Try again.\n";
+        }
+    }
+
+    void playGame(std::chrono::milliseconds budget) {
+        std::cout << "=== " << ROWS << "x" << COLS << " " << K << "-IN-A-ROW ===\n";
+        std::cout << "Enter moves as row col\n";
+
+        char choice;
+        std::cout << "Do you want to go first? (y/n): ";
+        std::cin >> choice;
+        bool humanIsX = (choice == 'y' || choice == 'Y');
+        if (humanIsX) setPlayers('O', 'X');
+        else setPlayers('X', 'O');
+        std::cout << (humanIsX ? "You are X (first), AI is O\n" : "AI is X (first), You are O\n");
+
+        displayBoard();
+        bool xTurn = true;
+
+        while (true) {
+            char mover = xTurn ? 'X' : 'O';
+            std::pair<int, int> move;
+            if (mover == HUMAN_PLAYER) {
+                move = getHumanMove();
+            } else {
+                move = getBestMove(budget);
+                std::cout << "AI chooses position (" << move.first << ", " << move.second << ")\n";
+                if (detailedStats) std::cout << stats.toJson() << "\n";
+            }
+            bool won = makeMove(move.first, move.second, mover);
+            displayBoard();
+
+            if (won) {
+                std::cout << mover << " WINS!\n";
+                break;
+            }
+            if (isFull()) {
+                std::cout << "IT'S A DRAW!\n";
+                break;
+            }
+            xTurn = !xTurn;
+        }
+    }
+};
+
+// main() is left out when the file is included by the tournament harness
+#ifndef ENGINE_NO_MAIN
+int main() {
+    std::cout << "Choose a board:\n";
+    std::cout << "1. 3x3, 3 in a row\n";
+    std::cout << "2. 4x4, 4 in a row\n";
+    std::cout << "3. 7x7, 4 in a row\n";
+    std::cout << "4. 15x15, 5 in a row (Gomoku)\n";
+    std::cout << "Enter choice (1-4): ";
+    int choice;
+    std::cin >> choice;
+
+    int budgetMs;
+    std::cout << "Enter AI time per move in ms: ";
+    std::cin >> budgetMs;
+    std::chrono::milliseconds budget(budgetMs);
+
+    int threads = 1, mode = 1;
+    std::cout << "Enter number of search threads (1 = serial): ";
+    std::cin >> threads;
+    if (threads > 1) {
+        std::cout << "Parallel mode (1 = Lazy SMP, 2 = root splitting): ";
+        std::cin >> mode;
+    }
+
+    char showStats;
+    std::cout << "Print search statistics as JSON after each AI move? (y/n): ";
+    std::cin >> showStats;
+
+    auto play = [&](auto&& game) {
+        using Game = std::decay_t<decltype(game)>;
+        game.setDetailedStats(showStats == 'y' || showStats == 'Y');
+        game.setParallelSearch(threads, mode == 2 ? Game::ParallelMode::ROOT_SPLIT : Game::ParallelMode::LAZY_SMP);
+        if (game.loadTablebase(Game::tablebaseFileName()))
+            std::cout << "Using tablebase " << Game::tablebaseFileName() << "\n";
+        game.playGame(budget);
+    };
+
+    switch (choice) {
+        case 1: play(MNKAlphaBeta<3, 3, 3>()); break;
+        case 2: play(MNKAlphaBeta<4, 4, 4>()); break;
+        case 3: play(MNKAlphaBeta<7, 7, 4>()); break;
+        default: play(MNKAlphaBeta<15, 15, 5>()); break;
+    }
+
+    std::cout << "Thanks for playing!\n";
+    return 0;
+}
+#endif
@@ -0,0 +1,513 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+#include <sstream>
+#include <bitset>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+
+// m,n,k game (k in a row on an m x n board) played by Monte Carlo Tree Search (UCT)
+// with random playouts; several threads grow one shared tree (tree parallelism)
+template <int ROWS, int COLS, int K>
+class MNKMonteCarlo {
+public:
+    // Statistics of one getBestMove() call, read from the tree after the search threads
+    // have joined (nothing is counted per playout). Win rates are for the AI: a win counts
+    // 1, a draw 0.5.
+    struct SearchStats {
+        const char* source = "mcts";
+        long long playouts = 0;
+        int treeNodes = 0;
+        double winRate = 0;                 // Of the chosen move
+        double timeMs = 0;
+        std::vector<int> rootMoves;         // Root children as cells, with their visits and win rates
+        std::vector<int> rootVisits;
+        std::vector<double> rootWinRates;
+        std::vector<int> pv;                // Most visited line, starting with the AI move
+
+        std::string toJson() const {
+            std::ostringstream out;
+            auto cell = [&out](int move) { out << "[" << move / COLS << ", " << move % COLS << "]"; };
+            out << "{\"source\": \"" << source << "\", \"playouts\": " << playouts << ", \"treeNodes\": " << treeNodes
+                << ", \"winRate\": " << winRate << ", \"timeMs\": " << timeMs << ", \"rootChildren\": [";
+            for (size_t i = 0; i < rootMoves.size(); i++) {
+                out << (i ? ", " : "") << "{\"move\": ";
+                cell(rootMoves[i]);
+                out << ", \"visits\": " << rootVisits[i] << ", \"winRate\": " << rootWinRates[i] << "}";
+            }
+            out << "], \"pv\": [";
+            for (size_t i = 0; i < pv.size(); i++) {
+                if (i) out << ", ";
+                cell(pv[i]);
+            }
+            out << "]}";
+            return out.str();
+        }
+    };
+
+private:
+    static constexpr int CELLS = ROWS * COLS;
+    static constexpr double EXPLORATION = 1.41;     // UCT constant c
+    static constexpr int EXPAND_AFTER = 2;          // Visits before a leaf gets children (root: always)
+
+    using Bits = std::bitset<CELLS>;
+    using Clock = std::chrono::steady_clock;
+
+    Bits stones[2];             // stones[0] = X, stones[1] = O
+    int moveCount = 0;
+    char AI_PLAYER = 'X';
+    char HUMAN_PLAYER = 'O';
+    char EMPTY = '.';
+    bool verbose = true;
+    SearchStats stats;
+
+    // Tree node. Counters are atomic so that threads can update them without locks;
+    // `visits` is incremented on the way down (virtual loss), so other threads see a
+    // node that is being searched as temporarily worse and spread out over the tree.
+    struct Node {
+        std::atomic<int> visits{0};
+        std::atomic<int> score{0};          // 2 per win, 1 per draw, for the player who moved into the node
+        std::atomic<int> state{0};          // LEAF, EXPANDING or EXPANDED
+        int move = -1;
+        int firstChild = -1;                // Children are stored contiguously in the pool
+        int childCount = 0;
+        int8_t outcome = 0;                 // ONGOING, MOVER_WINS or DRAW once the move is made
+    };
+    enum NodeState { LEAF, EXPANDING, EXPANDED };
+    enum Outcome { ONGOING, MOVER_WINS, DRAW };
+
+    // Node pool, allocated once; a search only bumps `poolUsed` and never frees
+    std::vector<Node> pool;
+    std::atomic<int> poolUsed{0};
+
+    int threadCount = 1;
+
+    // Per-move budget shared by the search threads
+    std::atomic<long long> playoutsDone{0};
+    long long playoutLimit = 0;
+    Clock::time_point deadline;
+
+    // Small fast generator, one per thread
+    struct XorShift {
+        uint64_t state;
+        explicit XorShift(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL | 1) {}
+        uint32_t next(uint32_t bound) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return (uint32_t)((state >> 32) * bound >> 32);
+        }
+    };
+
+    // Board state private to one search thread
+    struct Position {
+        Bits stones[2];
+        int moveCount;
+    };
+
+    static int sideOf(char player) { return player == 'X' ? 0 : 1; }
+
+    // True if the stone just placed at `cell` completes K in a row for `side`
+    static bool winsAt(const Bits& own, int cell) {
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int r = cell / COLS, c = cell % COLS;
+        for (const auto& d : directions) {
+            int run = 1;
+            for (int sign = -1; sign <= 1; sign += 2) {
+                int nr = r + sign * d[0], nc = c + sign * d[1];
+                while (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && own[nr * COLS + nc]) {
+                    run++;
+                    nr += sign * d[0];
+                    nc += sign * d[1];
+                }
+            }
+            if (run >= K) return true;
+        }
+        return false;
+    }
+
+    // Empty cells within distance 2 of an existing stone (the centre on an empty board);
+    // the tree only branches on these, playouts may use any empty cell
+    static std::vector<int> candidateMoves(const Position& pos) {
+        std::vector<int> moves;
+        if (pos.moveCount == 0) {
+            moves.push_back((ROWS / 2) * COLS + COLS / 2);
+            return moves;
+        }
+        Bits occupied = pos.stones[0] | pos.stones[1];
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (occupied[cell]) continue;
+            int r = cell / COLS, c = cell % COLS;
+            bool near = false;
+            for (int dr = -2; dr <= 2 && !near; dr++) {
+                for (int dc = -2; dc <= 2 && !near; dc++) {
+                    int nr = r + dr, nc = c + dc;
+                    if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && occupied[nr * COLS + nc]) near = true;
+                }
+            }
+            if (near) moves.push_back(cell);
+        }
+        return moves;
+    }
+
+    // Takes `count` consecutive nodes from the pool; -1 if the pool is exhausted
+    int allocate(int count) {
+        int first = poolUsed.fetch_add(count);
+        if (first + count > (int)pool.size()) return -1;
+        for (int i = first; i < first + count; i++) {
+            pool[i].visits.store(0, std::memory_order_relaxed);
+            pool[i].score.store(0, std::memory_order_relaxed);
+            pool[i].state.store(LEAF, std::memory_order_relaxed);
+            pool[i].firstChild = -1;
+            pool[i].childCount = 0;
+            pool[i].outcome = ONGOING;
+        }
+        return first;
+    }
+
+    // Creates the children of `nodeIndex` for `side` to move; only the thread that moved the
+    // node from LEAF to EXPANDING gets here, the others keep treating it as a leaf
+    void expand(int nodeIndex, Position& pos, int side) {
+        Node& node = pool[nodeIndex];
+        std::vector<int> moves = candidateMoves(pos);
+        int first = allocate((int)moves.size());
+        if (first < 0) {                    // Pool full: the node stays a leaf for good
+            return;
+        }
+        for (size_t i = 0; i < moves.size(); i++) {
+            Node& child = pool[first + i];
+            child.move = moves[i];
+            pos.stones[side][moves[i]] = true;
+            if (winsAt(pos.stones[side], moves[i])) child.outcome = MOVER_WINS;
+            else if (pos.moveCount + 1 == CELLS) child.outcome = DRAW;
+            pos.stones[side][moves[i]] = false;
+        }
+        node.firstChild = first;
+        node.childCount = (int)moves.size();
+        node.state.store(EXPANDED, std::memory_order_release);
+    }
+
+    // UCT: exploitation (average score) plus an exploration bonus for rarely visited children
+    int selectChild(const Node& node) const {
+        int parentVisits = std::max(1, node.visits.load(std::memory_order_relaxed));
+        double logParent = std::log((double)parentVisits);
+        int best = node.firstChild;
+        double bestValue = -1.0;
+        for (int i = node.firstChild; i < node.firstChild + node.childCount; i++) {
+            int visits = pool[i].visits.load(std::memory_order_relaxed);
+            if (visits == 0) return i;      // Try every child once
+            double mean = pool[i].score.load(std::memory_order_relaxed) / (2.0 * visits);
+            double value = mean + EXPLORATION * std::sqrt(logParent / visits);
+            if (value > bestValue) {
+                bestValue = value;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // Plays random moves to the end of the game; returns the winning side or -1 for a draw
+    static int playout(Position pos, int side, XorShift& rng) {
+        int empties[CELLS];
+        int count = 0;
+        Bits occupied = pos.stones[0] | pos.stones[1];
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (!occupied[cell]) empties[count++] = cell;
+        }
+        while (count > 0) {
+            int pick = rng.next(count);
+            int cell = empties[pick];
+            empties[pick] = empties[--count];
+            pos.stones[side][cell] = true;
+            if (winsAt(pos.stones[side], cell)) return side;
+            side = 1 - side;
+        }
+        return -1;
+    }
+
+    // One selection → expansion → playout → backpropagation pass
+    void iterate(int rootSide, XorShift& rng, std::vector<int>& path) {
+        Position pos{{stones[0], stones[1]}, moveCount};
+        int side = rootSide;                // Side to move at the current node
+        int nodeIndex = 0;
+        path.clear();
+        path.push_back(0);
+        pool[0].visits.fetch_add(1, std::memory_order_relaxed);
+
+        int winner = -2;                    // -2: not decided yet, -1: draw
+        while (true) {
+            Node& node = pool[nodeIndex];
+            if (node.outcome == MOVER_WINS) { winner = 1 - side; break; }
+            if (node.outcome == DRAW) { winner = -1; break; }
+
+            int state = node.state.load(std::memory_order_acquire);
+            if (state == LEAF && (nodeIndex == 0 || node.visits.load(std::memory_order_relaxed) > EXPAND_AFTER)) {
+                int expected = LEAF;
+                if (node.state.compare_exchange_strong(expected, EXPANDING)) {
+                    expand(nodeIndex, pos, side);
+                    state = node.state.load(std::memory_order_acquire);
+                }
+            }
+            if (state != EXPANDED) break;
+
+            nodeIndex = selectChild(node);
+            Node& child = pool[nodeIndex];
+            child.visits.fetch_add(1, std::memory_order_relaxed);   // Virtual loss until backpropagation
+            pos.stones[side][child.move] = true;
+            pos.moveCount++;
+            side = 1 - side;
+            path.push_back(nodeIndex);
+        }
+
+        if (winner == -2) winner = playout(pos, side, rng);
+
+        // The player who moved into the node at depth d is rootSide for odd d
+        for (size_t depth = 0; depth < path.size(); depth++) {
+            int mover = depth % 2 == 1 ? rootSide : 1 - rootSide;
+            int points = winner == -1 ? 1 : winner == mover ? 2 : 0;
+            if (points) pool[path[depth]].score.fetch_add(points, std::memory_order_relaxed);
+        }
+    }
+
+    bool budgetLeft() {
+        if (playoutLimit > 0) return playoutsDone.fetch_add(1, std::memory_order_relaxed) < playoutLimit;
+        playoutsDone.fetch_add(1, std::memory_order_relaxed);
+        return Clock::now() < deadline;
+    }
+
+    void searchThread(int rootSide, uint64_t seed) {
+        XorShift rng(seed);
+        std::vector<int> path;
+        path.reserve(CELLS + 1);
+        while (budgetLeft()) iterate(rootSide, rng, path);
+    }
+
+public:
+    explicit MNKMonteCarlo(size_t poolSize = 1 << 20) : pool(poolSize) {
+        initializeBoard();
+    }
+
+    void initializeBoard() {
+        stones[0].reset();
+        stones[1].reset();
+        moveCount = 0;
+    }
+
+    void setPlayers(char ai, char human) {
+        AI_PLAYER = ai;
+        HUMAN_PLAYER = human;
+    }
+
+    void setThreads(int threads) {
+        threadCount = std::max(1, threads);
+    }
+
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+
+    // Playouts run by the last getBestMove()
+    long long getPlayouts() const {
+        return playoutLimit > 0 ? std::min(playoutsDone.load(), playoutLimit) : playoutsDone.load();
+    }
+
+    const SearchStats& getStats() const {
+        return stats;
+    }
+
+    void displayBoard() const {
+        std::cout << "\n   ";
+        for (int c = 0; c < COLS; c++) std::cout << (c < 10 ? " " : "") << c << " ";
+        std::cout << "\n";
+        for (int r = 0; r < ROWS; r++) {
+            std::cout << (r < 10 ? " " : "") << r << " ";
+            for (int c = 0; c < COLS; c++) {
+                int cell = r * COLS + c;
+                std::cout << "  " << (stones[0][cell] ? 'X' : stones[1][cell] ? 'O' : EMPTY);
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    bool isValidMove(int row, int col) const {
+        return row >= 0 && row < ROWS && col >= 0 && col < COLS &&
+               !stones[0][row * COLS + col] && !stones[1][row * COLS + col];
+    }
+
+    // Places a stone; returns true if it wins the game
+    bool makeMove(int row, int col, char player) {
+        int cell = row * COLS + col;
+        stones[sideOf(player)][cell] = true;
+        moveCount++;
+        return winsAt(stones[sideOf(player)], cell);
+    }
+
+    bool isFull() const { return moveCount == CELLS; }
+
+    // Grows a fresh tree from the current position until `playouts` playouts have been run
+    // (or, if playouts is 0, until `budget` has passed) and plays the most visited move
+    std::pair<int, int> getBestMove(long long playouts, std::chrono::milliseconds budget) {
+        if (verbose) std::cout << "AI is thinking...\n";
+        auto start = Clock::now();
+        int rootSide = sideOf(AI_PLAYER);
+        playoutLimit = playouts;
+        playoutsDone = 0;
+        deadline = Clock::now() + budget;
+        poolUsed = 0;
+        allocate(1);
+        pool[0].move = -1;
+
+        // One playout before the threads start expands the root, so even a 0 ms budget gives a move
+        std::vector<int> path;
+        XorShift rng(0);
+        iterate(rootSide, rng, path);
+        playoutsDone = 1;
+
+        std::vector<std::thread> threads;
+        for (int id = 1; id < threadCount; id++) {
+            threads.emplace_back(&MNKMonteCarlo::searchThread, this, rootSide, (uint64_t)id + 1);
+        }
+        searchThread(rootSide, 1);
+        for (auto& thread : threads) thread.join();
+
+        auto winRate = [this](int index) {
+            return pool[index].score / (2.0 * std::max(1, pool[index].visits.load()));
+        };
+        auto mostVisited = [this](const Node& node) {
+            int best = node.firstChild;
+            for (int i = node.firstChild; i < node.firstChild + node.childCount; i++) {
+                if (pool[i].visits > pool[best].visits) best = i;
+            }
+            return best;
+        };
+
+        const Node& root = pool[0];
+        int best = mostVisited(root);
+
+        stats = SearchStats();
+        stats.playouts = getPlayouts();
+        stats.treeNodes = std::min<int>(poolUsed, (int)pool.size());
+        stats.winRate = winRate(best);
+        stats.timeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        for (int i = root.firstChild; i < root.firstChild + root.childCount; i++) {
+            stats.rootMoves.push_back(pool[i].move);
+            stats.rootVisits.push_back(pool[i].visits);
+            stats.rootWinRates.push_back(winRate(i));
+        }
+        for (int index = best; index != -1; ) {
+            stats.pv.push_back(pool[index].move);
+            const Node& node = pool[index];
+            index = node.state.load() == EXPANDED && node.childCount > 0 ? mostVisited(node) : -1;
+            if (index != -1 && pool[index].visits == 0) break;     // Line ends where the tree was not explored
+        }
+
+        if (verbose)
+            std::cout << "Ran " << stats.playouts << " playouts, " << stats.treeNodes
+                  << " tree nodes, win rate " << (int)(100.0 * stats.winRate) << "%\n";
+        return {pool[best].move / COLS, pool[best].move % COLS};
+    }
+
+    std::pair<int, int> getHumanMove() const {
+        int row, col;
+        while (true) {
+            std::cout << "Enter your move (row col): ";
+            std::cin >> row >> col;
+            if (isValidMove(row, col)) return {row, col};
+            std::cout << "Invalid move! Try again.\n";
+        }
+    }
+
+    void playGame(long long playouts, std::chrono::milliseconds budget, bool showStats = false) {
+        std::cout << "=== " << ROWS << "x" << COLS << " " << K << "-IN-A-ROW (MCTS) ===\n";
+        std::cout << "Enter moves as row col\n";
+
+        char choice;
+        std::cout << "Do you want to go first? (y/n): ";
+        std::cin >> choice;
+        bool humanIsX = (choice == 'y' || choice == 'Y');
+        if (humanIsX) setPlayers('O', 'X');
+        else setPlayers('X', 'O');
+        std::cout << (humanIsX ? "You are X (first), AI is O\n" : "AI is X (first), You are O\n");
+
+        displayBoard();
+        bool xTurn = true;
+
+        while (true) {
+            char mover = xTurn ? 'X' : 'O';
+            std::pair<int, int> move;
+            if (mover == HUMAN_PLAYER) {
+                move = getHumanMove();
+            } else {
+                move = getBestMove(playouts, budget);
+                std::cout << "AI chooses position (" << move.first << ", " << move.second << ")\n";
+                if (showStats) std::cout << stats.toJson() << "\n";
+            }
+            bool won = makeMove(move.first, move.second, mover);
+            displayBoard();
+
+            if (won) {
+                std::cout << mover << " WINS!\n";
+                break;
+            }
+            if (isFull()) {
+                std::cout << "IT'S A DRAW!\n";
+                break;
+            }
+            xTurn = !xTurn;
+        }
+    }
+};
+
+// main() is left out when the file is included by the tournament harness
+#ifndef ENGINE_NO_MAIN
+int main() {
+    std::cout << "Choose a board:\n";
+    std::cout << "1. 3x3, 3 in a row\n";
+    std::cout << "2. 4x4, 4 in a row\n";
+    std::cout << "3. 7x7, 4 in a row\n";
+    std::cout << "4. 15x15, 5 in a row (Gomoku)\n";
+    std::cout << "Enter choice (1-4): ";
+    int choice;
+    std::cin >> choice;
+
+    long long playouts;
+    int budgetMs = 0;
+    std::cout << "Enter playouts per move (0 = use a time budget): ";
+    std::cin >> playouts;
+    if (playouts <= 0) {
+        playouts = 0;
+        std::cout << "Enter AI time per move in ms: ";
+        std::cin >> budgetMs;
+    }
+    std::chrono::milliseconds budget(budgetMs);
+
+    int threads;
+    std::cout << "Enter number of search threads: ";
+    std::cin >> threads;
+
+    char showStats;
+    std::cout << "Print search statistics as JSON after each AI move? (y/n): ";
+    std::cin >> showStats;
+
+    auto play = [&](auto&& game) {
+        game.setThreads(threads);
+        game.playGame(playouts, budget, showStats == 'y' || showStats == 'Y');
+    };
+
+    switch (choice) {
+        case 1: play(MNKMonteCarlo<3, 3, 3>()); break;
+        case 2: play(MNKMonteCarlo<4, 4, 4>()); break;
+        case 3: play(MNKMonteCarlo<7, 7, 4>()); break;
+        default: play(MNKMonteCarlo<15, 15, 5>()); break;
+    }
+
+    std::cout << "Thanks for playing!\n";
+    return 0;
+}
+#endif
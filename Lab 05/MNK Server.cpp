@@ -0,0 +1,415 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Use the m,n,k engine as a library (its interactive main() is left out)
+#define ENGINE_NO_MAIN
+#include "MNK Alpha-Beta.cpp"
+
+// Long-running game server: many concurrent games over a line protocol on stdin/stdout
+// or a Unix socket. AI moves run on a thread pool; all games on the same board share
+// one engine prototype, and so one transposition table (and tablebase, if present).
+//
+// Protocol (one command per line, one reply line per command):
+//   NEW <board>              → OK <id>                   boards: 3x3x3 4x4x4 7x7x4 15x15x5
+//   MOVE <id> <row> <col>    → OK <id> <status>          status: CONTINUE X_WINS O_WINS DRAW
+//   AI <id> [ms]             → AI <id> <row> <col> <status>   (answered when the search ends)
+//   BOARD <id>               → BOARD <id> <row 0>/<row 1>/...
+//   END <id>                 → OK <id>
+//   STATS                    → STATS sessions=<n> moves=<n> ai_moves=<n> queued=<n>
+//   QUIT                     → closes the connection
+// Errors are reported as ERR <message>.
+
+// Fixed set of worker threads fed from one task queue
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable ready;
+    std::condition_variable idle;
+    int active = 0;
+    bool stopping = false;
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                active++;
+            }
+            task();
+            std::lock_guard<std::mutex> guard(lock);
+            active--;
+            if (active == 0 && tasks.empty()) idle.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads) {
+        for (int i = 0; i < threads; i++) workers.emplace_back(&ThreadPool::run, this);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        idle.wait(guard, [this] { return active == 0 && tasks.empty(); });
+    }
+
+    size_t queued() {
+        std::lock_guard<std::mutex> guard(lock);
+        return tasks.size();
+    }
+};
+
+// One connection (or stdin/stdout); replies from worker threads are serialised per client
+class Client {
+private:
+    int fd;
+    bool isSocket;
+    std::mutex writeLock;
+
+public:
+    std::string inbox;          // Bytes received but not yet split into lines
+
+    Client(int fileDescriptor, bool socket) : fd(fileDescriptor), isSocket(socket) {}
+
+    ~Client() {
+        if (isSocket) close(fd);
+    }
+
+    int descriptor() const { return fd; }
+
+    void send(const std::string& line) {
+        std::string data = line + "\n";
+        std::lock_guard<std::mutex> guard(writeLock);
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = isSocket ? ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL)
+                                 : ::write(fd, data.data() + sent, data.size() - sent);
+            if (n <= 0) return;             // Peer went away; drop the reply
+            sent += n;
+        }
+    }
+};
+
+// Board-independent view of one game
+class GameSession {
+public:
+    virtual ~GameSession() = default;
+    virtual bool isValidMove(int row, int col) const = 0;
+    virtual std::string play(int row, int col) = 0;                     // Returns the status
+    virtual std::pair<int, int> aiMove(std::chrono::milliseconds budget) = 0;
+    virtual std::string board() const = 0;
+    virtual bool finished() const = 0;
+};
+
+template <int ROWS, int COLS, int K>
+class MNKSession : public GameSession {
+private:
+    MNKAlphaBeta<ROWS, COLS, K> engine;     // Copy of the prototype: shares its table
+    char toMove = 'X';
+    std::string status = "CONTINUE";
+
+public:
+    explicit MNKSession(const MNKAlphaBeta<ROWS, COLS, K>& prototype) : engine(prototype) {}
+
+    bool isValidMove(int row, int col) const override { return engine.isValidMove(row, col); }
+
+    std::string play(int row, int col) override {
+        char mover = toMove;
+        bool won = engine.makeMove(row, col, mover);
+        toMove = mover == 'X' ? 'O' : 'X';
+        if (won) status = mover == 'X' ? "X_WINS" : "O_WINS";
+        else if (engine.isFull()) status = "DRAW";
+        return status;
+    }
+
+    std::pair<int, int> aiMove(std::chrono::milliseconds budget) override {
+        engine.setPlayers(toMove, toMove == 'X' ? 'O' : 'X');
+        return engine.getBestMove(budget);
+    }
+
+    std::string board() const override {
+        std::string text;
+        for (int r = 0; r < ROWS; r++) {
+            if (r) text += '/';
+            for (int c = 0; c < COLS; c++) text += engine.cellAt(r, c);
+        }
+        return text;
+    }
+
+    bool finished() const override { return status != "CONTINUE"; }
+};
+
+class GameServer {
+private:
+    // One quiet engine per board; sessions are copies, so they share its table
+    template <int ROWS, int COLS, int K>
+    static MNKAlphaBeta<ROWS, COLS, K> makePrototype() {
+        MNKAlphaBeta<ROWS, COLS, K> engine;
+        engine.setVerbose(false);
+        engine.loadTablebase(engine.tablebaseFileName());
+        return engine;
+    }
+
+    MNKAlphaBeta<3, 3, 3> board333 = makePrototype<3, 3, 3>();
+    MNKAlphaBeta<4, 4, 4> board444 = makePrototype<4, 4, 4>();
+    MNKAlphaBeta<7, 7, 4> board774 = makePrototype<7, 7, 4>();
+    MNKAlphaBeta<15, 15, 5> board15155 = makePrototype<15, 15, 5>();
+
+    struct Session {
+        std::mutex lock;
+        bool busy = false;                  // An AI move is being computed
+        std::unique_ptr<GameSession> game;
+        const Client* owner;
+    };
+
+    std::mutex sessionsLock;
+    std::unordered_map<int, std::shared_ptr<Session>> sessions;
+    int nextId = 1;
+    std::atomic<long long> moves{0};
+    std::atomic<long long> aiMoves{0};
+    ThreadPool pool;
+
+    std::unique_ptr<GameSession> createGame(const std::string& board) {
+        if (board == "3x3x3") return std::unique_ptr<GameSession>(new MNKSession<3, 3, 3>(board333));
+        if (board == "4x4x4") return std::unique_ptr<GameSession>(new MNKSession<4, 4, 4>(board444));
+        if (board == "7x7x4") return std::unique_ptr<GameSession>(new MNKSession<7, 7, 4>(board774));
+        if (board == "15x15x5") return std::unique_ptr<GameSession>(new MNKSession<15, 15, 5>(board15155));
+        return nullptr;
+    }
+
+    std::shared_ptr<Session> findSession(int id) {
+        std::lock_guard<std::mutex> guard(sessionsLock);
+        auto it = sessions.find(id);
+        return it == sessions.end() ? nullptr : it->second;
+    }
+
+    void requestAiMove(int id, const std::shared_ptr<Session>& session, int budgetMs,
+                       const std::shared_ptr<Client>& client) {
+        {
+            std::lock_guard<std::mutex> guard(session->lock);
+            if (session->busy) return client->send("ERR " + std::to_string(id) + " busy");
+            if (session->game->finished()) return client->send("ERR " + std::to_string(id) + " game over");
+            session->busy = true;
+        }
+        // While `busy` is set no other command touches the game, so the search runs
+        // without holding the session lock
+        pool.submit([this, id, session, budgetMs, client] {
+            std::pair<int, int> move = session->game->aiMove(std::chrono::milliseconds(budgetMs));
+            std::string status = session->game->play(move.first, move.second);
+            {
+                std::lock_guard<std::mutex> guard(session->lock);
+                session->busy = false;
+            }
+            moves++;
+            aiMoves++;
+            client->send("AI " + std::to_string(id) + " " + std::to_string(move.first) + " " +
+                         std::to_string(move.second) + " " + status);
+        });
+    }
+
+public:
+    explicit GameServer(int threads) : pool(threads) {}
+
+    // Parses and executes one protocol line; returns false on QUIT
+    bool handle(const std::string& line, const std::shared_ptr<Client>& client) {
+        std::istringstream in(line);
+        std::string command;
+        if (!(in >> command)) return true;
+
+        if (command == "QUIT") return false;
+        if (command == "STATS") {
+            size_t open;
+            {
+                std::lock_guard<std::mutex> guard(sessionsLock);
+                open = sessions.size();
+            }
+            client->send("STATS sessions=" + std::to_string(open) + " moves=" + std::to_string(moves) +
+                         " ai_moves=" + std::to_string(aiMoves) + " queued=" + std::to_string(pool.queued()));
+            return true;
+        }
+        if (command == "NEW") {
+            std::string board;
+            in >> board;
+            std::unique_ptr<GameSession> game = createGame(board);
+            if (!game) {
+                client->send("ERR unknown board " + board);
+                return true;
+            }
+            auto session = std::make_shared<Session>();
+            session->game = std::move(game);
+            session->owner = client.get();
+            int id;
+            {
+                std::lock_guard<std::mutex> guard(sessionsLock);
+                id = nextId++;
+                sessions[id] = session;
+            }
+            client->send("OK " + std::to_string(id));
+            return true;
+        }
+
+        int id;
+        if (!(in >> id)) {
+            client->send("ERR bad command");
+            return true;
+        }
+        std::shared_ptr<Session> session = findSession(id);
+        if (!session) {
+            client->send("ERR " + std::to_string(id) + " no such game");
+            return true;
+        }
+
+        if (command == "MOVE") {
+            int row, col;
+            if (!(in >> row >> col)) {
+                client->send("ERR " + std::to_string(id) + " expected row and col");
+                return true;
+            }
+            std::lock_guard<std::mutex> guard(session->lock);
+            if (session->busy) client->send("ERR " + std::to_string(id) + " busy");
+            else if (session->game->finished()) client->send("ERR " + std::to_string(id) + " game over");
+            else if (!session->game->isValidMove(row, col)) client->send("ERR " + std::to_string(id) + " invalid move");
+            else {
+                moves++;
+                client->send("OK " + std::to_string(id) + " " + session->game->play(row, col));
+            }
+        } else if (command == "AI") {
+            int budgetMs = 50;
+            in >> budgetMs;
+            requestAiMove(id, session, budgetMs, client);
+        } else if (command == "BOARD") {
+            std::lock_guard<std::mutex> guard(session->lock);
+            if (session->busy) client->send("ERR " + std::to_string(id) + " busy");
+            else client->send("BOARD " + std::to_string(id) + " " + session->game->board());
+        } else if (command == "END") {
+            std::lock_guard<std::mutex> guard(sessionsLock);
+            sessions.erase(id);             // A pending AI task keeps its own reference
+            client->send("OK " + std::to_string(id));
+        } else {
+            client->send("ERR unknown command " + command);
+        }
+        return true;
+    }
+
+    // Drops every game of a client that disconnected
+    void closeClient(const Client* client) {
+        std::lock_guard<std::mutex> guard(sessionsLock);
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            if (it->second->owner == client) it = sessions.erase(it);
+            else ++it;
+        }
+    }
+
+    void drain() { pool.wait(); }
+};
+
+// stdin/stdout mode: commands are read in order, AI replies may arrive out of order
+void serveStdin(GameServer& server) {
+    auto client = std::make_shared<Client>(STDOUT_FILENO, false);
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!server.handle(line, client)) break;
+    }
+    server.drain();
+}
+
+// Unix socket mode: one poll() loop reads from every connection, the pool does the searching
+int serveSocket(GameServer& server, const std::string& path) {
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+    if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 128) < 0) {
+        std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cerr << "Listening on " << path << "\n";
+
+    std::vector<std::shared_ptr<Client>> clients;
+    while (true) {
+        std::vector<pollfd> fds(1, pollfd{listener, POLLIN, 0});
+        for (const auto& client : clients) fds.push_back(pollfd{client->descriptor(), POLLIN, 0});
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        std::vector<std::shared_ptr<Client>> stillOpen;
+        for (size_t i = 1; i < fds.size(); i++) {
+            std::shared_ptr<Client>& client = clients[i - 1];
+            bool open = true;
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char buffer[4096];
+                ssize_t n = read(client->descriptor(), buffer, sizeof(buffer));
+                if (n <= 0) open = false;
+                else client->inbox.append(buffer, n);
+
+                size_t newline;
+                while (open && (newline = client->inbox.find('\n')) != std::string::npos) {
+                    std::string line = client->inbox.substr(0, newline);
+                    client->inbox.erase(0, newline + 1);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    open = server.handle(line, client);
+                }
+            }
+            if (open) stillOpen.push_back(client);
+            else server.closeClient(client.get());      // The socket closes with the last reference
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd >= 0) stillOpen.push_back(std::make_shared<Client>(fd, true));
+        }
+        clients.swap(stillOpen);
+    }
+    close(listener);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: server [threads] [socket path]; without a path the protocol runs on stdin/stdout
+    int threads = argc > 1 ? std::max(1, std::atoi(argv[1])) : (int)std::max(1u, std::thread::hardware_concurrency());
+    GameServer server(threads);
+    if (argc > 2) return serveSocket(server, argv[2]);
+    serveStdin(server);
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+
+// Retrograde tablebase builder for small m,n,k boards (up to 16 cells, e.g. 4x4 four in a row).
+//
+// Every board is ranked in base 3 (digit c = 0 empty, 1 X, 2 O for cell c), so the table
+// is a flat array of 3^(m*n) one-byte entries, including illegal boards. That makes a probe
+// a single index and lets the engine memory-map the file.
+//
+// File layout: "MNKT", rows, cols, k, version (1 byte each), entry count (uint64, little
+// endian), then one byte per rank:
+//   bits 0-1  result for the side to move: 0 illegal, 1 win, 2 loss, 3 draw
+//   bits 2-7  distance to the end in moves with best play (win fast, lose slowly)
+enum TablebaseResult : uint8_t { TB_ILLEGAL, TB_WIN, TB_LOSS, TB_DRAW };
+
+template <int ROWS, int COLS, int K>
+class MNKTablebaseBuilder {
+private:
+    static constexpr int CELLS = ROWS * COLS;
+    static_assert(CELLS <= 16, "3^cells entries must fit in memory");
+
+    // A rank splits into a low and a high half of at most 8 digits each; a 3^8 table turns
+    // either half into X and O bitmasks, so decoding a rank is two lookups
+    static constexpr int LOW_DIGITS = CELLS < 8 ? CELLS : 8;
+    static constexpr int HIGH_DIGITS = CELLS - LOW_DIGITS;
+
+    uint64_t pow3[CELLS + 1];
+    uint64_t entries;
+    std::vector<uint16_t> halfX, halfO;         // Masks of a half rank (indexed by its value)
+    std::vector<uint32_t> lines;                // Every k-in-a-row line as a cell mask
+    std::vector<uint8_t> table;
+
+    void buildLines() {
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                for (const auto& d : directions) {
+                    int endR = r + d[0] * (K - 1), endC = c + d[1] * (K - 1);
+                    if (endR < 0 || endR >= ROWS || endC < 0 || endC >= COLS) continue;
+                    uint32_t mask = 0;
+                    for (int i = 0; i < K; i++) mask |= 1u << ((r + d[0] * i) * COLS + (c + d[1] * i));
+                    lines.push_back(mask);
+                }
+            }
+        }
+    }
+
+    bool hasLine(uint32_t bits) const {
+        for (uint32_t line : lines)
+            if ((bits & line) == line) return true;
+        return false;
+    }
+
+    // Solves one position; every position with one more stone must already be solved
+    void solveEntry(uint64_t rank, uint32_t x, uint32_t o) {
+        int nx = __builtin_popcount(x), no = __builtin_popcount(o);
+        if (nx != no && nx != no + 1) return;               // Stays TB_ILLEGAL
+        int side = nx == no ? 0 : 1;                        // 0 = X to move
+        bool xLine = hasLine(x), oLine = hasLine(o);
+        bool moverLine = side == 0 ? xLine : oLine;         // Side to move already has k in a row
+        bool lastLine = side == 0 ? oLine : xLine;
+        if (moverLine) return;                              // Game would have ended earlier
+
+        if (lastLine) {
+            table[rank] = TB_LOSS;                          // Opponent has just won
+            return;
+        }
+        uint32_t empty = ((1u << CELLS) - 1) & ~(x | o);
+        if (!empty) {
+            table[rank] = TB_DRAW;
+            return;
+        }
+
+        int bestWin = 64, worstLoss = -1;
+        bool draw = false;
+        for (uint32_t moves = empty; moves; moves &= moves - 1) {
+            int cell = __builtin_ctz(moves);
+            uint8_t child = table[rank + (side + 1) * pow3[cell]];
+            int dte = child >> 2;
+            if ((child & 3) == TB_LOSS) bestWin = std::min(bestWin, dte + 1);
+            else if ((child & 3) == TB_DRAW) draw = true;
+            else worstLoss = std::max(worstLoss, dte + 1);
+        }
+        if (bestWin < 64) table[rank] = TB_WIN | bestWin << 2;
+        else if (draw) table[rank] = TB_DRAW;
+        else table[rank] = TB_LOSS | worstLoss << 2;
+    }
+
+public:
+    MNKTablebaseBuilder() {
+        pow3[0] = 1;
+        for (int i = 1; i <= CELLS; i++) pow3[i] = pow3[i - 1] * 3;
+        entries = pow3[CELLS];
+
+        halfX.assign(pow3[LOW_DIGITS], 0);
+        halfO.assign(pow3[LOW_DIGITS], 0);
+        for (uint64_t half = 0; half < pow3[LOW_DIGITS]; half++) {
+            uint64_t rest = half;
+            for (int digit = 0; digit < LOW_DIGITS; digit++, rest /= 3) {
+                if (rest % 3 == 1) halfX[half] |= 1 << digit;
+                if (rest % 3 == 2) halfO[half] |= 1 << digit;
+            }
+        }
+        buildLines();
+    }
+
+    // Retrograde analysis: positions with n stones only lead to positions with n + 1, so
+    // solving from the full board down to the empty board needs one pass per stone count.
+    // Within a pass the positions are independent and are split across threads by high half.
+    void build(int threadCount) {
+        table.assign(entries, TB_ILLEGAL);
+        uint64_t highCount = pow3[HIGH_DIGITS];
+        uint64_t lowCount = pow3[LOW_DIGITS];
+
+        for (int stones = CELLS; stones >= 0; stones--) {
+            std::atomic<uint64_t> nextHigh(0);
+            auto worker = [&] {
+                uint64_t high;
+                while ((high = nextHigh.fetch_add(1)) < highCount) {
+                    uint32_t highX = (uint32_t)halfX[high] << LOW_DIGITS;
+                    uint32_t highO = (uint32_t)halfO[high] << LOW_DIGITS;
+                    int highStones = __builtin_popcount(highX | highO);
+                    if (highStones > stones) continue;
+                    for (uint64_t low = 0; low < lowCount; low++) {
+                        uint32_t x = highX | halfX[low], o = highO | halfO[low];
+                        if (__builtin_popcount(x | o) != stones) continue;
+                        solveEntry(high * lowCount + low, x, o);
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (int t = 1; t < threadCount; t++) threads.emplace_back(worker);
+            worker();
+            for (auto& thread : threads) thread.join();
+        }
+    }
+
+    uint8_t rootEntry() const { return table[0]; }
+
+    // Counts legal positions by result
+    void printSummary() const {
+        long long counts[4] = {0, 0, 0, 0};
+        for (uint8_t entry : table) counts[entry & 3]++;
+        std::cout << "Legal positions: " << counts[TB_WIN] + counts[TB_LOSS] + counts[TB_DRAW]
+                  << " (win " << counts[TB_WIN] << ", loss " << counts[TB_LOSS] << ", draw " << counts[TB_DRAW] << ")\n";
+        const char* names[4] = {"illegal", "first player wins", "first player loses", "draw"};
+        std::cout << "Empty board: " << names[rootEntry() & 3];
+        if ((rootEntry() & 3) == TB_WIN || (rootEntry() & 3) == TB_LOSS) std::cout << " in " << (rootEntry() >> 2) << " moves";
+        std::cout << "\n";
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        const char header[8] = {'M', 'N', 'K', 'T', (char)ROWS, (char)COLS, (char)K, 1};
+        out.write(header, sizeof(header));
+        for (int i = 0; i < 8; i++) out.put((char)(entries >> (8 * i)));
+        out.write((const char*)table.data(), table.size());
+        return (bool)out;
+    }
+};
+
+template <int ROWS, int COLS, int K>
+void buildTablebase(int threads) {
+    std::string path = "mnk_" + std::to_string(ROWS) + "x" + std::to_string(COLS) + "x" + std::to_string(K) + ".tb";
+    std::cout << "Building " << ROWS << "x" << COLS << ", " << K << " in a row on " << threads << " thread(s)...\n";
+
+    auto start = std::chrono::steady_clock::now();
+    MNKTablebaseBuilder<ROWS, COLS, K> builder;
+    builder.build(threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Solved in " << seconds << " s\n";
+    builder.printSummary();
+    if (builder.save(path)) std::cout << "Wrote " << path << "\n";
+    else std::cout << "Could not write " << path << "\n";
+}
+
+int main() {
+    std::cout << "Choose a board:\n";
+    std::cout << "1. 3x3, 3 in a row\n";
+    std::cout << "2. 3x4, 3 in a row\n";
+    std::cout << "3. 4x4, 3 in a row\n";
+    std::cout << "4. 4x4, 4 in a row\n";
+    std::cout << "Enter choice (1-4): ";
+    int choice;
+    std::cin >> choice;
+
+    int threads;
+    std::cout << "Enter number of threads: ";
+    std::cin >> threads;
+    threads = std::max(1, threads);
+
+    switch (choice) {
+        case 1: buildTablebase<3, 3, 3>(threads); break;
+        case 2: buildTablebase<3, 4, 3>(threads); break;
+        case 3: buildTablebase<4, 4, 3>(threads); break;
+        default: buildTablebase<4, 4, 4>(threads); break;
+    }
+    return 0;
+}
@@ -2,140 +2,524 @@
 #include <vector>
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <chrono>
+#include <sstream>
+#include <string>
 
 class AlphaBetaTicTacToe {
 private:
-    char board[3][3];
+    // Bitboard: one 9-bit mask per player, bit (3 * row + col) set if the cell is taken
+    uint16_t xBits = 0;
+    uint16_t oBits = 0;
     char AI_PLAYER = 'X';
     char HUMAN_PLAYER = 'O';
+    bool verbose = true;
+    bool detailedStats = false;     // Nodes per ply, principal variation and timing (see SearchStats)
     char EMPTY = ' ';
 
+    static constexpr uint16_t FULL_BOARD = 0x1FF;
+    static constexpr uint16_t WIN_LINES[8] = {
+        0x007, 0x038, 0x1C0,    // Rows
+        0x049, 0x092, 0x124,    // Columns
+        0x111, 0x054            // Diagonals
+    };
+
+    uint16_t& bitsOf(char player) {
+        return player == 'X' ? xBits : oBits;
+    }
+
+    uint16_t emptyCells() const {
+        return FULL_BOARD & ~(xBits | oBits);
+    }
+
+    char cellAt(int row, int col) const {
+        uint16_t bit = 1 << (3 * row + col);
+        if (xBits & bit) return 'X';
+        if (oBits & bit) return 'O';
+        return EMPTY;
+    }
+
+    static constexpr bool hasLine(uint16_t bits) {
+        for (uint16_t line : WIN_LINES)
+            if ((bits & line) == line) return true;
+        return false;
+    }
+
+    // ---- Transposition table ----
+    // Positions are keyed by the Zobrist hash of their canonical form (the smallest of
+    // the eight rotations/reflections), so symmetric positions and transpositions share
+    // one entry. Best moves are stored in canonical coordinates.
+    enum Bound : uint8_t { EXACT, LOWER, UPPER };
+
+    struct TTEntry {
+        uint64_t key = 0;
+        int8_t value = 0;       // Stored relative to the node (see toTT/fromTT)
+        Bound bound = EXACT;
+        int8_t bestMove = -1;   // Canonical cell index, -1 if none
+    };
+
+    static constexpr int TT_SIZE = 1 << 12;    // Power of two; 3x3 has < 5,478 positions
+    std::vector<TTEntry> table = std::vector<TTEntry>(TT_SIZE);
+
+    struct Symmetries {
+        uint8_t cell[8][9];         // Image of each cell under each symmetry
+        uint16_t mask[8][512];      // Image of every 9-bit mask
+        uint64_t zobrist[2][9];     // Random key per (player, cell)
+        uint64_t sideKey[2][2];     // [AI is X][maximizing to move]
+    };
+
+    static const Symmetries& symmetries() {
+        static const Symmetries sym = [] {
+            Symmetries t{};
+            for (int s = 0; s < 8; s++) {
+                for (int cell = 0; cell < 9; cell++) {
+                    int r = cell / 3, c = cell % 3;
+                    for (int k = 0; k < s % 4; k++) {   // Rotate 90 degrees s % 4 times
+                        int nr = c, nc = 2 - r;
+                        r = nr;
+                        c = nc;
+                    }
+                    if (s >= 4) c = 2 - c;              // Then mirror
+                    t.cell[s][cell] = 3 * r + c;
+                }
+                for (int m = 0; m < 512; m++)
+                    for (int cell = 0; cell < 9; cell++)
+                        if (m >> cell & 1) t.mask[s][m] |= 1 << t.cell[s][cell];
+            }
+            uint64_t seed = 0x9E3779B97F4A7C15ULL;     // splitmix64, fixed seed
+            auto next = [&seed] {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            };
+            for (auto& player : t.zobrist) for (uint64_t& key : player) key = next();
+            for (auto& ai : t.sideKey) for (uint64_t& key : ai) key = next();
+            return t;
+        }();
+        return sym;
+    }
+
+    // Hash of the canonical form; `symmetry` receives the transform that produces it
+    uint64_t canonicalKey(bool isMaximizing, int& symmetry) const {
+        const Symmetries& sym = symmetries();
+        uint32_t best = UINT32_MAX;
+        for (int s = 0; s < 8; s++) {
+            uint32_t code = sym.mask[s][xBits] | (uint32_t)sym.mask[s][oBits] << 9;
+            if (code < best) {
+                best = code;
+                symmetry = s;
+            }
+        }
+        uint64_t key = sym.sideKey[AI_PLAYER == 'X'][isMaximizing];
+        for (int cell = 0; cell < 9; cell++) {
+            if (best >> cell & 1) key ^= sym.zobrist[0][cell];
+            if (best >> (cell + 9) & 1) key ^= sym.zobrist[1][cell];
+        }
+        return key;
+    }
+
+    // ---- Move ordering ----
+    // Moves are tried as: transposition-table move, the two killer moves of this depth
+    // (moves that caused a cutoff in a sibling), then by history score. Each stage can be
+    // switched off through setMoveOrdering() to measure its effect on the cutoff rate.
+public:
+    struct MoveOrdering {
+        bool ttMoveFirst = true;
+        bool killers = true;
+        bool history = true;
+        bool pvs = true;        // Principal variation search (null windows after the first move)
+    };
+
+    // Statistics of one getBestMove() or searchBestMove() call. The counters are always kept;
+    // plyNodes, pv and timeMs are only filled with setDetailedStats(true), so a normal search
+    // pays one predictable branch per node.
+    struct SearchStats {
+        static constexpr int MAX_PLY = 10;
+        const char* source = "search";      // "search", or "table" for a perfect-play lookup
+        long long nodes = 0;
+        long long cutoffs = 0;
+        long long firstMoveCutoffs = 0;     // Cutoffs caused by the first move tried
+        long long researches = 0;           // PVS null-window searches that had to be repeated
+        long long ttHits = 0;
+        long long plyNodes[MAX_PLY] = {};   // Nodes by distance from the root (1 = after the AI move)
+        double timeMs = 0;                  // Whole search; one depth-first pass has no per-ply time
+        std::vector<int> pv;                // Principal variation as cells, starting with the AI move
+
+        double firstMoveCutoffRate() const { return cutoffs ? (double)firstMoveCutoffs / cutoffs : 0.0; }
+
+        // Deepest ply that was reached (0 without detailed statistics)
+        int depth() const {
+            int deepest = 0;
+            for (int ply = 1; ply < MAX_PLY; ply++)
+                if (plyNodes[ply]) deepest = ply;
+            return deepest;
+        }
+
+        // Effective branching factor b: the uniform tree of the same depth with
+        // b + b^2 + ... + b^depth = nodes, solved by bisection
+        double branchingFactor() const {
+            int d = depth();
+            if (d == 0) return 0.0;
+            double low = 0.0, high = (double)nodes;
+            for (int step = 0; step < 64; step++) {
+                double b = (low + high) / 2, total = 0.0, power = 1.0;
+                for (int ply = 0; ply < d && total <= nodes; ply++) total += power *= b;
+                (total > nodes ? high : low) = b;
+            }
+            return low;
+        }
+
+        std::string toJson() const {
+            std::ostringstream out;
+            out << "{\"source\": \"" << source << "\", \"nodes\": " << nodes << ", \"cutoffs\": " << cutoffs
+                << ", \"firstMoveCutoffRate\": " << firstMoveCutoffRate() << ", \"researches\": " << researches
+                << ", \"ttHits\": " << ttHits << ", \"depth\": " << depth()
+                << ", \"branchingFactor\": " << branchingFactor() << ", \"timeMs\": " << timeMs << ", \"plyNodes\": [";
+            for (int ply = 1; ply <= depth(); ply++) out << (ply > 1 ? ", " : "") << plyNodes[ply];
+            out << "], \"pv\": [";
+            for (size_t i = 0; i < pv.size(); i++) out << (i ? ", " : "") << "[" << pv[i] / 3 << ", " << pv[i] % 3 << "]";
+            out << "]}";
+            return out.str();
+        }
+    };
+
+private:
+    MoveOrdering ordering;
+    SearchStats stats;
+    int killerMoves[9][2];
+    int historyScore[2][9];     // [maximizing side][cell]
+
+    // Fills `moves` with the empty cells in search order; returns how many there are
+    int orderMoves(int moves[9], int depth, bool isMaximizing, int ttMove) const {
+        int scores[9];
+        int count = 0;
+        for (uint16_t empty = emptyCells(); empty; empty &= empty - 1) {
+            int cell = __builtin_ctz(empty);
+            int score = 0;
+            if (ordering.ttMoveFirst && cell == ttMove) score = 1 << 30;
+            else if (ordering.killers && cell == killerMoves[depth][0]) score = 1 << 29;
+            else if (ordering.killers && cell == killerMoves[depth][1]) score = 1 << 28;
+            else if (ordering.history) score = historyScore[isMaximizing][cell];
+            // Insertion sort by descending score; equal scores keep the lower cell first
+            int i = count++;
+            for (; i > 0 && scores[i - 1] < score; i--) {
+                moves[i] = moves[i - 1];
+                scores[i] = scores[i - 1];
+            }
+            moves[i] = cell;
+            scores[i] = score;
+        }
+        return count;
+    }
+
+    void recordCutoff(int depth, bool isMaximizing, int cell, int moveIndex) {
+        stats.cutoffs++;
+        if (moveIndex == 0) stats.firstMoveCutoffs++;
+        if (killerMoves[depth][0] != cell) {
+            killerMoves[depth][1] = killerMoves[depth][0];
+            killerMoves[depth][0] = cell;
+        }
+        historyScore[isMaximizing][cell] += (9 - depth) * (9 - depth);
+    }
+
+    void resetSearch() {
+        stats = SearchStats();
+        for (auto& killers : killerMoves) killers[0] = killers[1] = -1;
+        for (auto& side : historyScore) for (int& score : side) score = 0;
+    }
+
+    // Scores encode the depth of the result (10 - depth), so they are stored relative
+    // to the node to stay valid when the position is reached at another depth
+    static int toTT(int value, int depth) { return value > 0 ? value + depth : value < 0 ? value - depth : 0; }
+    static int fromTT(int value, int depth) { return value > 0 ? value - depth : value < 0 ? value + depth : 0; }
+
+    // ---- Perfect-play table, generated at compile time ----
+    // Positions are indexed by their base-3 code (cell digit: 0 = empty, 1 = X, 2 = O).
+    // value is from the side to move's point of view: +/-(10 - plies to the end) for a
+    // win/loss, 0 for a draw, so quicker wins and slower losses score higher, exactly as
+    // in minimax(). move is the lowest cell with the best value (-1 at terminal positions).
+    static constexpr int POSITIONS = 19683;    // 3^9
+
+    struct PerfectPlayTable {
+        int8_t value[POSITIONS];
+        int8_t move[POSITIONS];
+        int16_t base3[512];     // base3[mask] = sum of 3^cell over the set bits
+        uint8_t popcount[512];
+    };
+
+    // Retrograde solve: positions with more pieces are finished before those with fewer,
+    // so every child is already known when its parent is evaluated
+    static constexpr PerfectPlayTable solvePerfectPlay() {
+        PerfectPlayTable t{};
+        for (int m = 0; m < 512; m++) {
+            int power = 1;
+            for (int cell = 0; cell < 9; cell++, power *= 3) {
+                if (m >> cell & 1) {
+                    t.base3[m] += power;
+                    t.popcount[m]++;
+                }
+            }
+        }
+
+        for (int pieces = 9; pieces >= 0; pieces--) {
+            for (int x = 0; x < 512; x++) {
+                int rest = FULL_BOARD & ~x;
+                for (int o = rest; ; o = (o - 1) & rest) {     // Every subset of the free cells
+                    int cx = t.popcount[x], co = t.popcount[o];
+                    if (cx + co == pieces && (cx == co || cx == co + 1)) {
+                        bool xToMove = cx == co;
+                        int mine = xToMove ? x : o, theirs = xToMove ? o : x;
+                        int code = t.base3[x] + 2 * t.base3[o];
+                        t.move[code] = -1;
+
+                        if (hasLine(theirs)) t.value[code] = -10;
+                        else if (hasLine(mine)) t.value[code] = 10;
+                        else if (pieces == 9) t.value[code] = 0;
+                        else {
+                            int best = -128;
+                            for (int cell = 0; cell < 9; cell++) {
+                                if ((x | o) >> cell & 1) continue;
+                                int child = code + (xToMove ? 1 : 2) * t.base3[1 << cell];
+                                int v = -t.value[child];
+                                v = v > 0 ? v - 1 : v < 0 ? v + 1 : 0;   // One ply further away
+                                if (v > best) {
+                                    best = v;
+                                    t.move[code] = cell;
+                                }
+                            }
+                            t.value[code] = best;
+                        }
+                    }
+                    if (o == 0) break;
+                }
+            }
+        }
+        return t;
+    }
+
+    static const PerfectPlayTable& perfectPlay() {
+        static constexpr PerfectPlayTable table = solvePerfectPlay();
+        return table;
+    }
+
+    // Perfect-play line from the current board, read from the table
+    std::vector<int> tableLine() const {
+        const PerfectPlayTable& table = perfectPlay();
+        std::vector<int> line;
+        uint16_t x = xBits, o = oBits;
+        for (int cell; (cell = table.move[table.base3[x] + 2 * table.base3[o]]) != -1;) {
+            line.push_back(cell);
+            (table.popcount[x] == table.popcount[o] ? x : o) |= 1 << cell;
+        }
+        return line;
+    }
+
+    // Principal variation after the AI plays `first`: follows the best moves stored in the
+    // transposition table until the game ends or a position is missing
+    std::vector<int> ttLine(int first) {
+        uint16_t savedX = xBits, savedO = oBits;
+        std::vector<int> line = {first};
+        bitsOf(AI_PLAYER) |= 1 << first;
+        for (bool isMaximizing = false; checkGameStatus() == 'C'; isMaximizing = !isMaximizing) {
+            int symmetry = 0;
+            uint64_t key = canonicalKey(isMaximizing, symmetry);
+            const TTEntry& entry = table[key & (TT_SIZE - 1)];
+            if (entry.key != key || entry.bestMove == -1) break;
+            int move = -1;
+            for (int cell = 0; cell < 9; cell++)
+                if (symmetries().cell[symmetry][cell] == entry.bestMove) move = cell;
+            line.push_back(move);
+            bitsOf(isMaximizing ? AI_PLAYER : HUMAN_PLAYER) |= 1 << move;
+        }
+        xBits = savedX;
+        oBits = savedO;
+        return line;
+    }
+
 public:
     AlphaBetaTicTacToe() {
         initializeBoard();
+        resetSearch();
+    }
+
+    void setMoveOrdering(const MoveOrdering& newOrdering) {
+        ordering = newOrdering;
+    }
+
+    void setPlayers(char ai, char human) {
+        AI_PLAYER = ai;
+        HUMAN_PLAYER = human;
+    }
+
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+
+    // Also collect nodes per ply, the principal variation and the search time
+    void setDetailedStats(bool enabled) {
+        detailedStats = enabled;
+    }
+
+    // Statistics of the last getBestMove() or searchBestMove() call
+    const SearchStats& getStats() const {
+        return stats;
     }
 
     void initializeBoard() {
-        for (int i = 0; i < 3; i++)
-            for (int j = 0; j < 3; j++)
-                board[i][j] = EMPTY;
+        xBits = 0;
+        oBits = 0;
     }
 
     void displayBoard() {
         std::cout << "\n   0   1   2\n";
         for (int i = 0; i < 3; i++) {
-            std::cout << i << "  " << board[i][0] << " | " << board[i][1] << " | " << board[i][2] << "\n";
+            std::cout << i << "  " << cellAt(i, 0) << " | " << cellAt(i, 1) << " | " << cellAt(i, 2) << "\n";
             if (i < 2) std::cout << "  ---|---|---\n";
         }
         std::cout << "\n";
     }
 
     bool isValidMove(int row, int col) {
-        return (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == EMPTY);
+        return (row >= 0 && row < 3 && col >= 0 && col < 3 && (emptyCells() >> (3 * row + col) & 1));
     }
 
     void makeMove(int row, int col, char player) {
-        board[row][col] = player;
+        bitsOf(player) |= 1 << (3 * row + col);
     }
 
     void undoMove(int row, int col) {
-        board[row][col] = EMPTY;
+        uint16_t bit = 1 << (3 * row + col);
+        xBits &= ~bit;
+        oBits &= ~bit;
     }
 
+    // Win = eight mask tests, draw = full board
     char checkGameStatus() {
-        // Rows
-        for (int i = 0; i < 3; i++)
-            if (board[i][0] == board[i][1] && board[i][1] == board[i][2] && board[i][0] != EMPTY)
-                return board[i][0];
-
-        // Columns
-        for (int j = 0; j < 3; j++)
-            if (board[0][j] == board[1][j] && board[1][j] == board[2][j] && board[0][j] != EMPTY)
-                return board[0][j];
-
-        // Diagonals
-        if (board[0][0] == board[1][1] && board[1][1] == board[2][2] && board[0][0] != EMPTY)
-            return board[0][0];
-        if (board[0][2] == board[1][1] && board[1][1] == board[2][0] && board[0][2] != EMPTY)
-            return board[0][2];
-
-        // Draw?
-        bool full = true;
-        for (int i = 0; i < 3; i++)
-            for (int j = 0; j < 3; j++)
-                if (board[i][j] == EMPTY)
-                    full = false;
-
-        if (full) return 'D'; // Draw
+        if (hasLine(xBits)) return 'X';
+        if (hasLine(oBits)) return 'O';
+        if ((xBits | oBits) == FULL_BOARD) return 'D'; // Draw
         return 'C'; // Continue
     }
 
-    // ✅ Minimax with Alpha-Beta pruning
+    // ✅ Minimax with Alpha-Beta pruning and a transposition table
     int minimax(int depth, bool isMaximizing, int alpha, int beta) {
+        stats.nodes++;
+        if (detailedStats) stats.plyNodes[depth + 1]++;
         char status = checkGameStatus();
 
         if (status == AI_PLAYER) return 10 - depth;
         if (status == HUMAN_PLAYER) return -10 + depth;
         if (status == 'D') return 0;
 
-        if (isMaximizing) {
-            int bestVal = INT_MIN;
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    if (isValidMove(i, j)) {
-                        makeMove(i, j, AI_PLAYER);
-                        int eval = minimax(depth + 1, false, alpha, beta);
-                        undoMove(i, j);
-                        bestVal = std::max(bestVal, eval);
-                        alpha = std::max(alpha, bestVal);
-
-                        // 🔥 Prune
-                        if (beta <= alpha)
-                            return bestVal;
-                    }
+        // Probe before expanding children
+        int symmetry = 0;
+        uint64_t key = canonicalKey(isMaximizing, symmetry);
+        TTEntry& entry = table[key & (TT_SIZE - 1)];
+        int ttMove = -1;
+        if (entry.key == key) {
+            stats.ttHits++;
+            int value = fromTT(entry.value, depth);
+            if (entry.bound == EXACT) return value;
+            if (entry.bound == LOWER) alpha = std::max(alpha, value);
+            if (entry.bound == UPPER) beta = std::min(beta, value);
+            if (beta <= alpha) return value;
+            // Map the stored canonical move back to this board's orientation
+            for (int cell = 0; cell < 9 && entry.bestMove != -1; cell++)
+                if (symmetries().cell[symmetry][cell] == entry.bestMove) ttMove = cell;
+        }
+        int alphaOrig = alpha, betaOrig = beta;
+
+        uint16_t& mover = bitsOf(isMaximizing ? AI_PLAYER : HUMAN_PLAYER);
+        int bestVal = isMaximizing ? INT_MIN : INT_MAX;
+        int bestCell = -1;
+
+        int moves[9];
+        int count = orderMoves(moves, depth, isMaximizing, ttMove);
+        for (int i = 0; i < count; i++) {
+            int cell = moves[i];
+
+            mover |= 1 << cell;
+            int eval;
+            if (i == 0 || !ordering.pvs) {
+                eval = minimax(depth + 1, !isMaximizing, alpha, beta);
+            } else if (isMaximizing) {
+                // PVS: prove this move is no better than alpha with a null window
+                eval = minimax(depth + 1, false, alpha, alpha + 1);
+                if (eval > alpha && eval < beta) {
+                    stats.researches++;
+                    eval = minimax(depth + 1, false, alpha, beta);
                 }
-            }
-            return bestVal;
-        } else {
-            int bestVal = INT_MAX;
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    if (isValidMove(i, j)) {
-                        makeMove(i, j, HUMAN_PLAYER);
-                        int eval = minimax(depth + 1, true, alpha, beta);
-                        undoMove(i, j);
-                        bestVal = std::min(bestVal, eval);
-                        beta = std::min(beta, bestVal);
-
-                        // 🔥 Prune
-                        if (beta <= alpha)
-                            return bestVal;
-                    }
+            } else {
+                eval = minimax(depth + 1, true, beta - 1, beta);
+                if (eval < beta && eval > alpha) {
+                    stats.researches++;
+                    eval = minimax(depth + 1, true, alpha, beta);
                 }
             }
-            return bestVal;
+            mover &= ~(1 << cell);
+
+            if (isMaximizing ? eval > bestVal : eval < bestVal) {
+                bestVal = eval;
+                bestCell = cell;
+            }
+            if (isMaximizing) alpha = std::max(alpha, bestVal);
+            else beta = std::min(beta, bestVal);
+
+            // 🔥 Prune
+            if (beta <= alpha) {
+                recordCutoff(depth, isMaximizing, cell, i);
+                break;
+            }
         }
+
+        entry.key = key;
+        entry.value = toTT(bestVal, depth);
+        entry.bound = bestVal <= alphaOrig ? UPPER : bestVal >= betaOrig ? LOWER : EXACT;
+        entry.bestMove = symmetries().cell[symmetry][bestCell];
+        return bestVal;
     }
 
+    // Perfect move by table lookup; falls back to search if the board is not a
+    // position where the AI is the side to move (e.g. set up by hand)
     std::pair<int, int> getBestMove() {
-        std::cout << "AI is thinking...\n";
+        if (verbose) std::cout << "AI is thinking...\n";
+        const PerfectPlayTable& table = perfectPlay();
+        bool aiToMove = (table.popcount[xBits] == table.popcount[oBits]) == (AI_PLAYER == 'X');
+        int cell = table.move[table.base3[xBits] + 2 * table.base3[oBits]];
+        if (!aiToMove || cell == -1) return searchBestMove();
+
+        stats = SearchStats();
+        stats.source = "table";
+        if (detailedStats) stats.pv = tableLine();
+        return {cell / 3, cell % 3};
+    }
+
+    // Best move by full search over every AI move
+    std::pair<int, int> searchBestMove() {
+        resetSearch();
+        auto start = std::chrono::steady_clock::now();
         int bestVal = INT_MIN;
         std::pair<int, int> bestMove = {-1, -1};
+        uint16_t& aiBits = bitsOf(AI_PLAYER);
 
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (isValidMove(i, j)) {
-                    makeMove(i, j, AI_PLAYER);
-                    int moveVal = minimax(0, false, INT_MIN, INT_MAX);
-                    undoMove(i, j);
-
-                    if (moveVal > bestVal) {
-                        bestVal = moveVal;
-                        bestMove = {i, j};
-                    }
-                }
+        for (uint16_t moves = emptyCells(); moves; moves &= moves - 1) {
+            int cell = __builtin_ctz(moves);
+            aiBits |= 1 << cell;
+            int moveVal = minimax(0, false, INT_MIN, INT_MAX);
+            aiBits &= ~(1 << cell);
+
+            if (moveVal > bestVal) {
+                bestVal = moveVal;
+                bestMove = {cell / 3, cell % 3};
             }
         }
+
+        if (detailedStats && bestMove.first != -1) {
+            stats.pv = ttLine(3 * bestMove.first + bestMove.second);
+            stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
         return bestMove;
     }
 
@@ -188,6 +572,7 @@ public:
                 auto aiMove = getBestMove();
                 makeMove(aiMove.first, aiMove.second, AI_PLAYER);
                 std::cout << "AI chooses position (" << aiMove.first << ", " << aiMove.second << ")\n";
+                if (detailedStats) std::cout << stats.toJson() << "\n";
                 displayBoard();
             }
 
@@ -196,9 +581,16 @@ public:
     }
 };
 
+// main() is left out when the file is included by the tournament harness
+#ifndef ENGINE_NO_MAIN
 int main() {
     AlphaBetaTicTacToe game;
 
+    char showStats;
+    std::cout << "Print search statistics as JSON after each AI move? (y/n): ";
+    std::cin >> showStats;
+    game.setDetailedStats(showStats == 'y' || showStats == 'Y');
+
     char playAgain;
     do {
         game.initializeBoard();
@@ -211,3 +603,4 @@ int main() {
     std::cout << "Thanks for playing!\n";
     return 0;
 }
+#endif
@@ -0,0 +1,154 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Batch evaluation of many 3x3 bitboards at once, for playouts and analysis.
+// Boards are stored as a structure of arrays: x[i] and o[i] are the 9-bit masks of board i.
+// The status codes match checkGameStatus() in the game programs: 'X', 'O', 'D' or 'C'.
+class TicTacToeBatch {
+private:
+    static constexpr uint16_t FULL_BOARD = 0x1FF;
+    static constexpr uint16_t WIN_LINES[8] = {
+        0x007, 0x038, 0x1C0,    // Rows
+        0x049, 0x092, 0x124,    // Columns
+        0x111, 0x054            // Diagonals
+    };
+
+    static char statusOf(uint16_t x, uint16_t o) {
+        bool xWins = false, oWins = false;
+        for (uint16_t line : WIN_LINES) {
+            xWins |= (x & line) == line;
+            oWins |= (o & line) == line;
+        }
+        if (xWins) return 'X';
+        if (oWins) return 'O';
+        if ((x | o) == FULL_BOARD) return 'D';
+        return 'C';
+    }
+
+public:
+    // Status and legal-move mask (empty cells, 0 once the game is over) of boards [0, n)
+    static void evaluate(const uint16_t* x, const uint16_t* o, size_t n, char* status, uint16_t* legal) {
+        size_t i = 0;
+#ifdef __AVX2__
+        // 16 boards per step: each line test is an AND and a compare on 16-bit lanes
+        const __m256i full = _mm256_set1_epi16(FULL_BOARD);
+        for (; i + 16 <= n; i += 16) {
+            __m256i xs = _mm256_loadu_si256((const __m256i*)(x + i));
+            __m256i os = _mm256_loadu_si256((const __m256i*)(o + i));
+            __m256i xWins = _mm256_setzero_si256(), oWins = _mm256_setzero_si256();
+            for (uint16_t mask : WIN_LINES) {
+                __m256i line = _mm256_set1_epi16(mask);
+                xWins = _mm256_or_si256(xWins, _mm256_cmpeq_epi16(_mm256_and_si256(xs, line), line));
+                oWins = _mm256_or_si256(oWins, _mm256_cmpeq_epi16(_mm256_and_si256(os, line), line));
+            }
+            __m256i taken = _mm256_or_si256(xs, os);
+            __m256i isFull = _mm256_cmpeq_epi16(taken, full);
+
+            // Priority X > O > draw > continue, as in checkGameStatus()
+            __m256i code = _mm256_set1_epi16('C');
+            code = _mm256_blendv_epi8(code, _mm256_set1_epi16('D'), isFull);
+            code = _mm256_blendv_epi8(code, _mm256_set1_epi16('O'), oWins);
+            code = _mm256_blendv_epi8(code, _mm256_set1_epi16('X'), xWins);
+            __m256i over = _mm256_or_si256(_mm256_or_si256(xWins, oWins), isFull);
+            __m256i moves = _mm256_andnot_si256(over, _mm256_andnot_si256(taken, full));
+            _mm256_storeu_si256((__m256i*)(legal + i), moves);
+
+            // Narrow the 16-bit codes to bytes (packus works per 128-bit half)
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(code, code), 0x08);
+            _mm_storeu_si128((__m128i*)(status + i), _mm256_castsi256_si128(packed));
+        }
+#endif
+        // Remaining boards (or all of them without AVX2); simple enough to auto-vectorise
+        for (; i < n; i++) {
+            status[i] = statusOf(x[i], o[i]);
+            legal[i] = status[i] == 'C' ? FULL_BOARD & ~(x[i] | o[i]) : 0;
+        }
+    }
+
+    // Plays n random games from the empty board in lockstep: every ply, all boards still in
+    // play get one move for the same side. Adds the results to counts ('X', 'O', 'D').
+    static void randomPlayouts(size_t n, uint64_t seed, long long counts[3]) {
+        std::vector<uint16_t> x(n, 0), o(n, 0), legal(n);
+        std::vector<char> status(n);
+        uint64_t state = seed * 0x9E3779B97F4A7C15ULL | 1;
+
+        for (int ply = 0; ply < 9; ply++) {
+            evaluate(x.data(), o.data(), n, status.data(), legal.data());
+            std::vector<uint16_t>& mover = ply % 2 == 0 ? x : o;
+            for (size_t i = 0; i < n; i++) {
+                uint16_t moves = legal[i];
+                if (!moves) continue;
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                int pick = (int)((state >> 32) * __builtin_popcount(moves) >> 32);
+#ifdef __BMI2__
+                mover[i] |= (uint16_t)_pdep_u32(1u << pick, moves);    // Deposit onto the pick-th empty cell
+#else
+                for (int k = 0; k < pick; k++) moves &= moves - 1;     // Select the pick-th empty cell
+                mover[i] |= moves & -moves;
+#endif
+            }
+        }
+        evaluate(x.data(), o.data(), n, status.data(), legal.data());
+        for (size_t i = 0; i < n; i++) counts[status[i] == 'X' ? 0 : status[i] == 'O' ? 1 : 2]++;
+    }
+
+    // Same games one board at a time, for comparison
+    static void randomPlayoutsScalar(size_t n, uint64_t seed, long long counts[3]) {
+        uint64_t state = seed * 0x9E3779B97F4A7C15ULL | 1;
+        for (size_t i = 0; i < n; i++) {
+            uint16_t bits[2] = {0, 0};
+            char status = 'C';
+            for (int ply = 0; ply < 9 && status == 'C'; ply++) {
+                uint16_t moves = FULL_BOARD & ~(bits[0] | bits[1]);
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                int pick = (int)((state >> 32) * __builtin_popcount(moves) >> 32);
+                for (int k = 0; k < pick; k++) moves &= moves - 1;
+                bits[ply % 2] |= moves & -moves;
+                status = statusOf(bits[0], bits[1]);
+            }
+            counts[status == 'X' ? 0 : status == 'O' ? 1 : 2]++;
+        }
+    }
+};
+
+int main() {
+    long long games;
+    std::cout << "Enter number of random games: ";
+    std::cin >> games;
+
+#ifdef __AVX2__
+    std::cout << "Batch evaluation uses AVX2 (16 boards per instruction)\n";
+#else
+    std::cout << "Batch evaluation uses the scalar loop (compile with -mavx2 for SIMD)\n";
+#endif
+
+    const size_t BATCH = 4096;      // Boards advanced in lockstep
+    long long batchCounts[3] = {0, 0, 0}, scalarCounts[3] = {0, 0, 0};
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long done = 0, seed = 1; done < games; done += BATCH, seed++)
+        TicTacToeBatch::randomPlayouts((size_t)std::min<long long>(BATCH, games - done), seed, batchCounts);
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    TicTacToeBatch::randomPlayoutsScalar((size_t)games, 1, scalarCounts);
+    double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto report = [games](const char* name, long long counts[3], double seconds) {
+        std::cout << name << ": X wins " << 100.0 * counts[0] / games << "%, O wins " << 100.0 * counts[1] / games
+                  << "%, draws " << 100.0 * counts[2] / games << "% (" << games / seconds / 1e6 << " M games/s)\n";
+    };
+    report("Batch ", batchCounts, batchSeconds);
+    report("Scalar", scalarCounts, scalarSeconds);
+    return 0;
+}
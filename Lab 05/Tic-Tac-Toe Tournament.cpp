@@ -0,0 +1,320 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+
+// Pull in every engine as a library (their interactive main() functions are left out)
+#define ENGINE_NO_MAIN
+#include "../Lab 02/Tic-Tac-Toe.cpp"
+#include "../Lab 04/Tic-Tac-Toe Minimax.cpp"
+#include "Tic-Tac-Toe Alpha-Beta.cpp"
+#include "MNK Alpha-Beta.cpp"
+#include "MNK MCTS.cpp"
+
+// Engine-vs-engine self-play on the 3x3 board with throughput metrics.
+// Every engine keeps its own board; the harness feeds both engines every move.
+class Engine {
+public:
+    virtual ~Engine() = default;
+    virtual void newGame(char side) = 0;                // side = symbol this engine plays
+    virtual void applyMove(int cell, char player) = 0;
+    virtual int chooseMove() = 0;
+    virtual long long nodes() const { return 0; }       // Work done by the last chooseMove()
+};
+
+// Adapter for the three tic-tac-toe classes, which share the same interface
+template <class Game>
+class TicTacToeEngine : public Engine {
+private:
+    Game game;
+    std::function<std::pair<int, int>(Game&)> pick;
+    std::function<long long(const Game&)> count;
+
+public:
+    TicTacToeEngine(std::function<std::pair<int, int>(Game&)> pickMove,
+                    std::function<long long(const Game&)> countNodes = nullptr)
+        : pick(pickMove), count(countNodes) {
+        game.setVerbose(false);
+    }
+
+    void newGame(char side) override {
+        game.initializeBoard();
+        game.setPlayers(side, side == 'X' ? 'O' : 'X');
+    }
+
+    void applyMove(int cell, char player) override { game.makeMove(cell / 3, cell % 3, player); }
+
+    int chooseMove() override {
+        std::pair<int, int> move = pick(game);
+        return move.first * 3 + move.second;
+    }
+
+    long long nodes() const override { return count ? count(game) : 0; }
+};
+
+// Adapter for the m,n,k engines, played on their 3,3,3 instance
+class MNKAlphaBetaEngine : public Engine {
+private:
+    MNKAlphaBeta<3, 3, 3> game;
+    std::chrono::milliseconds budget;
+
+public:
+    explicit MNKAlphaBetaEngine(std::chrono::milliseconds moveBudget) : budget(moveBudget) {
+        game.setVerbose(false);
+    }
+    void newGame(char side) override {
+        game.initializeBoard();
+        game.setPlayers(side, side == 'X' ? 'O' : 'X');
+    }
+    void applyMove(int cell, char player) override { game.makeMove(cell / 3, cell % 3, player); }
+    int chooseMove() override {
+        std::pair<int, int> move = game.getBestMove(budget);
+        return move.first * 3 + move.second;
+    }
+    long long nodes() const override { return game.getStats().nodes; }
+};
+
+class MNKMonteCarloEngine : public Engine {
+private:
+    MNKMonteCarlo<3, 3, 3> game{1 << 16};
+    long long playouts;
+
+public:
+    explicit MNKMonteCarloEngine(long long movePlayouts) : playouts(movePlayouts) {
+        game.setVerbose(false);
+    }
+    void newGame(char side) override {
+        game.initializeBoard();
+        game.setPlayers(side, side == 'X' ? 'O' : 'X');
+    }
+    void applyMove(int cell, char player) override { game.makeMove(cell / 3, cell % 3, player); }
+    int chooseMove() override {
+        std::pair<int, int> move = game.getBestMove(playouts, std::chrono::milliseconds(0));
+        return move.first * 3 + move.second;
+    }
+    long long nodes() const override { return game.getPlayouts(); }
+};
+
+// Registered engines: name → factory (each game thread builds its own instances)
+const std::vector<std::pair<std::string, std::function<std::unique_ptr<Engine>()>>>& engineRegistry() {
+    static const std::vector<std::pair<std::string, std::function<std::unique_ptr<Engine>()>>> registry = {
+        {"rule", [] {
+            return std::unique_ptr<Engine>(new TicTacToeEngine<TicTacToe>(
+                [](TicTacToe& g) { return g.getAIMove(); }));
+        }},
+        {"minimax", [] {
+            return std::unique_ptr<Engine>(new TicTacToeEngine<MinimaxTicTacToe>(
+                [](MinimaxTicTacToe& g) { return g.getBestMove(); }));
+        }},
+        {"minimax-search", [] {
+            return std::unique_ptr<Engine>(new TicTacToeEngine<MinimaxTicTacToe>(
+                [](MinimaxTicTacToe& g) { return g.searchBestMove(); },
+                [](const MinimaxTicTacToe& g) { return g.getStats().nodes; }));
+        }},
+        {"alphabeta", [] {
+            return std::unique_ptr<Engine>(new TicTacToeEngine<AlphaBetaTicTacToe>(
+                [](AlphaBetaTicTacToe& g) { return g.getBestMove(); }));
+        }},
+        {"alphabeta-search", [] {
+            return std::unique_ptr<Engine>(new TicTacToeEngine<AlphaBetaTicTacToe>(
+                [](AlphaBetaTicTacToe& g) { return g.searchBestMove(); },
+                [](const AlphaBetaTicTacToe& g) { return g.getStats().nodes; }));
+        }},
+        {"mnk-alphabeta", [] {
+            return std::unique_ptr<Engine>(new MNKAlphaBetaEngine(std::chrono::milliseconds(5)));
+        }},
+        {"mnk-mcts", [] {
+            return std::unique_ptr<Engine>(new MNKMonteCarloEngine(2000));
+        }},
+    };
+    return registry;
+}
+
+std::unique_ptr<Engine> createEngine(const std::string& name) {
+    for (const auto& entry : engineRegistry())
+        if (entry.first == name) return entry.second();
+    return nullptr;
+}
+
+// Per-engine results, collected per thread and merged at the end
+struct EngineReport {
+    int wins[2] = {0, 0};       // [0] playing X, [1] playing O
+    int draws[2] = {0, 0};
+    int losses[2] = {0, 0};
+    long long nodes = 0;
+    double thinkSeconds = 0;
+    std::vector<double> latencies;      // Microseconds per move
+
+    void merge(const EngineReport& other) {
+        for (int s = 0; s < 2; s++) {
+            wins[s] += other.wins[s];
+            draws[s] += other.draws[s];
+            losses[s] += other.losses[s];
+        }
+        nodes += other.nodes;
+        thinkSeconds += other.thinkSeconds;
+        latencies.insert(latencies.end(), other.latencies.begin(), other.latencies.end());
+    }
+};
+
+static constexpr uint16_t WIN_LINES[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+
+static bool hasLine(uint16_t bits) {
+    for (uint16_t line : WIN_LINES)
+        if ((bits & line) == line) return true;
+    return false;
+}
+
+// Plays one game; engine 0 is X in even games. The first `randomPlies` moves are
+// random so that deterministic engines do not replay the same game every time.
+void playOneGame(int gameIndex, Engine* engines[2], EngineReport reports[2], int randomPlies, std::mt19937& rng) {
+    int xEngine = gameIndex % 2;
+    engines[xEngine]->newGame('X');
+    engines[1 - xEngine]->newGame('O');
+
+    uint16_t bits[2] = {0, 0};          // [0] X, [1] O
+    int winner = -1;                    // Index into engines[], -1 for a draw
+    for (int ply = 0; ply < 9; ply++) {
+        int side = ply % 2;
+        char symbol = side == 0 ? 'X' : 'O';
+        int mover = side == 0 ? xEngine : 1 - xEngine;
+        uint16_t empty = 0x1FF & ~(bits[0] | bits[1]);
+
+        int cell;
+        if (ply < randomPlies) {
+            std::vector<int> cells;
+            for (int c = 0; c < 9; c++)
+                if (empty >> c & 1) cells.push_back(c);
+            cell = cells[rng() % cells.size()];
+        } else {
+            auto start = std::chrono::steady_clock::now();
+            cell = engines[mover]->chooseMove();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            reports[mover].thinkSeconds += seconds;
+            reports[mover].latencies.push_back(seconds * 1e6);
+            reports[mover].nodes += engines[mover]->nodes();
+        }
+        if (cell < 0 || cell > 8 || !(empty >> cell & 1)) {      // Illegal move forfeits
+            winner = 1 - mover;
+            break;
+        }
+
+        bits[side] |= 1 << cell;
+        engines[0]->applyMove(cell, symbol);
+        engines[1]->applyMove(cell, symbol);
+        if (hasLine(bits[side])) {
+            winner = mover;
+            break;
+        }
+    }
+
+    for (int e = 0; e < 2; e++) {
+        int colour = e == xEngine ? 0 : 1;
+        if (winner == -1) reports[e].draws[colour]++;
+        else if (winner == e) reports[e].wins[colour]++;
+        else reports[e].losses[colour]++;
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = std::min(sorted.size() - 1, (size_t)(p / 100.0 * sorted.size()));
+    return sorted[index];
+}
+
+void printReport(const std::string names[2], EngineReport reports[2], int games, int threads, double seconds) {
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n" << names[0] << " vs " << names[1] << ": " << games << " games on " << threads
+              << " thread(s) in " << seconds << " s (" << games / seconds << " games/s)\n\n";
+
+    std::cout << std::left << std::setw(18) << "Engine" << std::right
+              << std::setw(8) << "Colour" << std::setw(7) << "W" << std::setw(7) << "D" << std::setw(7) << "L" << "\n";
+    for (int e = 0; e < 2; e++) {
+        for (int s = 0; s < 3; s++) {
+            int w = s < 2 ? reports[e].wins[s] : reports[e].wins[0] + reports[e].wins[1];
+            int d = s < 2 ? reports[e].draws[s] : reports[e].draws[0] + reports[e].draws[1];
+            int l = s < 2 ? reports[e].losses[s] : reports[e].losses[0] + reports[e].losses[1];
+            std::cout << std::left << std::setw(18) << (s == 0 ? names[e] : "") << std::right
+                      << std::setw(8) << (s == 0 ? "X" : s == 1 ? "O" : "total")
+                      << std::setw(7) << w << std::setw(7) << d << std::setw(7) << l << "\n";
+        }
+    }
+
+    std::cout << "\nMove latency in microseconds\n";
+    std::cout << std::left << std::setw(18) << "Engine" << std::right << std::setw(9) << "moves"
+              << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90"
+              << std::setw(10) << "p99" << std::setw(10) << "max" << std::setw(14) << "nodes/s" << "\n";
+    for (int e = 0; e < 2; e++) {
+        std::vector<double>& lat = reports[e].latencies;
+        std::sort(lat.begin(), lat.end());
+        double mean = lat.empty() ? 0 : reports[e].thinkSeconds * 1e6 / lat.size();
+        double nodesPerSecond = reports[e].thinkSeconds > 0 ? reports[e].nodes / reports[e].thinkSeconds : 0;
+        std::cout << std::left << std::setw(18) << names[e] << std::right << std::setw(9) << lat.size()
+                  << std::setw(10) << mean << std::setw(10) << percentile(lat, 50) << std::setw(10) << percentile(lat, 90)
+                  << std::setw(10) << percentile(lat, 99) << std::setw(10) << (lat.empty() ? 0 : lat.back())
+                  << std::setw(14);
+        if (reports[e].nodes) std::cout << std::setprecision(0) << nodesPerSecond << std::setprecision(1);
+        else std::cout << "-";
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <engine A> <engine B> [games=1000] [threads=1] [random plies=2] [seed=1]\n";
+        std::cout << "Engines:";
+        for (const auto& entry : engineRegistry()) std::cout << " " << entry.first;
+        std::cout << "\n";
+        return 1;
+    }
+    std::string names[2] = {argv[1], argv[2]};
+    int games = argc > 3 ? std::atoi(argv[3]) : 1000;
+    int threads = argc > 4 ? std::max(1, std::atoi(argv[4])) : 1;
+    int randomPlies = argc > 5 ? std::atoi(argv[5]) : 2;
+    unsigned seed = argc > 6 ? (unsigned)std::atoi(argv[6]) : 1;
+
+    for (const std::string& name : names) {
+        if (!createEngine(name)) {
+            std::cout << "Unknown engine: " << name << "\n";
+            return 1;
+        }
+    }
+
+    // Games are handed out through an atomic counter; each thread owns its engines
+    std::atomic<int> nextGame(0);
+    std::mutex mergeLock;
+    EngineReport total[2];
+
+    auto worker = [&] {
+        std::unique_ptr<Engine> owned[2] = {createEngine(names[0]), createEngine(names[1])};
+        Engine* engines[2] = {owned[0].get(), owned[1].get()};
+        EngineReport local[2];
+        int game;
+        while ((game = nextGame.fetch_add(1)) < games) {
+            std::mt19937 rng(seed * 1000003u + game);       // Same openings for any thread count
+            playOneGame(game, engines, local, randomPlies, rng);
+        }
+        std::lock_guard<std::mutex> guard(mergeLock);
+        total[0].merge(local[0]);
+        total[1].merge(local[1]);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printReport(names, total, games, threads, seconds);
+    return 0;
+}